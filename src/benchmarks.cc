@@ -0,0 +1,592 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_containers.h"
+
+namespace {
+
+std::vector<int> ShuffledKeys(std::size_t n) {
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+  std::mt19937 gen(42);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  return keys;
+}
+
+}  // namespace
+
+static void BM_MapFind(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Map<int, int> map;
+  for (int key : keys) {
+    map.Insert(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.Find(keys[i]));
+    if (++i == n) i = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapFind)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oLogN);
+
+// Lookups from several threads into one shared const map, without a lock.
+// Items per second should grow with the thread count.
+static void BM_MapFindShared(benchmark::State& state) {
+  constexpr std::size_t kSize = 1 << 20;
+  static const std::vector<int> keys = ShuffledKeys(kSize);
+  static const s21::Map<int, int> map = [] {
+    s21::Map<int, int> built;
+    for (int key : keys) {
+      built.Insert(key, key);
+    }
+    return built;
+  }();
+  std::size_t i = static_cast<std::size_t>(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.Find(keys[i % kSize]));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapFindShared)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_StringMapFind(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<std::string> keys;
+  for (int key : ShuffledKeys(n)) {
+    keys.push_back("user/session/" + std::to_string(key));
+  }
+  s21::Map<std::string, int> map;
+  for (const std::string& key : keys) {
+    map.Insert(key, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.Find(keys[i]));
+    if (++i == n) i = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_StringMapFind)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity(benchmark::oLogN);
+
+static void BM_SetContainsMiss(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Set<int> set;
+  for (int key : keys) {
+    set.Insert(key * 2);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.Contains(keys[i] * 2 + 1));
+    if (++i == n) i = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SetContainsMiss)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oLogN);
+
+// Scans a window of 64 consecutive keys starting at a random key.
+static void BM_MapWindowScan(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Map<int, int> map;
+  for (int key : keys) {
+    map.Insert(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = map.LowerBound(keys[i]), end = map.LowerBound(keys[i] + 64);
+         it != end; ++it) {
+      sum += it.GetVal();
+    }
+    benchmark::DoNotOptimize(sum);
+    if (++i == n) i = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapWindowScan)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oLogN);
+
+// Reads the 99th percentile of a set that keeps subtree sizes.
+static void BM_SetPercentile(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  s21::Set<int, std::less<int>, std::allocator<int>, s21::OrderStatistic> set;
+  for (int key : ShuffledKeys(n)) {
+    set.Insert(key);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.Select(n * 99 / 100));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SetPercentile)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oLogN);
+
+// Sums the values of 1024 consecutive keys starting at a random key.
+static void BM_MapRangeSum(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Map<std::uint64_t, double, std::less<std::uint64_t>,
+           std::allocator<std::pair<const std::uint64_t, double>>,
+           s21::RangeAggregate<s21::SumMonoid<double>>>
+      map;
+  for (int key : keys) {
+    map.Insert(key, key * 0.5);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::uint64_t lo = static_cast<std::uint64_t>(keys[i]);
+    benchmark::DoNotOptimize(map.Aggregate(lo, lo + 1023));
+    if (++i == n) i = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapRangeSum)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oLogN);
+
+// Replays timestamped events in batches of four; many share a timestamp.
+static void BM_MultimapInsertMany(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    s21::Multimap<int, int> events;
+    for (std::size_t i = 0; i < n; i += 4) {
+      int t = static_cast<int>(i / 16);
+      events.InsertMany(std::make_pair(t, 0), std::make_pair(t, 1),
+                        std::make_pair(t, 2), std::make_pair(t + 1, 3));
+    }
+    benchmark::DoNotOptimize(events.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultimapInsertMany)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_MapIterate(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  s21::Map<int, int> map;
+  for (int key : ShuffledKeys(n)) {
+    map.Insert(key, key);
+  }
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = map.Begin(); it != map.End(); ++it) {
+      sum += it.GetVal();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapIterate)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Complexity(benchmark::oN);
+
+static void BM_MapCounter(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Map<int, long> counts;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    ++counts[keys[i] % 1024];
+    if (++i == n) i = 0;
+  }
+  benchmark::DoNotOptimize(counts.Size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapCounter)->Arg(1 << 16);
+
+static void BM_MapCopy(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  s21::Map<int, int> map;
+  for (int key : ShuffledKeys(n)) {
+    map.Insert(key, key);
+  }
+  for (auto _ : state) {
+    s21::Map<int, int> copy(map);
+    benchmark::DoNotOptimize(copy.GetRoot());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapCopy)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity(benchmark::oN);
+
+// Refreshing a snapshot that already holds as many elements.
+static void BM_MapCopyAssign(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  s21::Map<int, int> map;
+  for (int key : ShuffledKeys(n)) {
+    map.Insert(key, key);
+  }
+  s21::Map<int, int> snapshot(map);
+  for (auto _ : state) {
+    snapshot = map;
+    benchmark::DoNotOptimize(snapshot.GetRoot());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapCopyAssign)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_MapDestroy(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto* map = new s21::Map<int, int>;
+    for (int key : keys) {
+      map->Insert(key, key);
+    }
+    state.ResumeTiming();
+    delete map;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Few iterations: building the map between them dominates the run time.
+BENCHMARK(BM_MapDestroy)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Iterations(8);
+
+// The caller's side of a deferred delete; the reclaimer is flushed while
+// the timer is paused.
+static void BM_MapDeferredDelete(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Reclaimer::Instance().Flush();
+    s21::Map<int, std::string> map;
+    for (int key : keys) {
+      map.Insert(key, std::to_string(key));
+    }
+    state.ResumeTiming();
+    s21::DeferredDelete(std::move(map));
+  }
+  s21::Reclaimer::Instance().Flush();
+}
+BENCHMARK(BM_MapDeferredDelete)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 21)
+    ->Iterations(8);
+
+static void BM_MapMergeDelta(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n + n / 10);
+  s21::Map<int, int> base;
+  for (std::size_t i = 0; i < n; ++i) {
+    base.Insert(keys[i], keys[i]);
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Map<int, int> target(base);
+    s21::Map<int, int> delta;
+    for (std::size_t i = n / 2; i < keys.size(); ++i) {
+      delta.Insert(keys[i], keys[i]);
+    }
+    state.ResumeTiming();
+    target.Merge(delta);
+    benchmark::DoNotOptimize(target.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * (keys.size() - n / 2));
+}
+BENCHMARK(BM_MapMergeDelta)->RangeMultiplier(8)->Range(1 << 10, 1 << 18);
+
+static void BM_SetIntersection(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  s21::Set<int> lhs;
+  s21::Set<int> rhs;
+  for (std::size_t i = 0; i < n; ++i) {
+    lhs.Insert(keys[i]);
+    rhs.Insert(keys[i] + static_cast<int>(n / 2));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Set<int> target(lhs);
+    state.ResumeTiming();
+    target.Intersection(rhs);
+    benchmark::DoNotOptimize(target.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetIntersection)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// Inserts n keys in sorted (0), reverse (1) or random (2) order, either
+// with the position of the previous insert as hint or without any hint.
+template <bool kHinted>
+static void BM_SetInsertOrder(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  if (state.range(1) == 0) {
+    std::sort(keys.begin(), keys.end());
+  } else if (state.range(1) == 1) {
+    std::sort(keys.rbegin(), keys.rend());
+  }
+  for (auto _ : state) {
+    s21::Set<int> set;
+    auto hint = set.End();
+    for (int key : keys) {
+      if (kHinted) {
+        hint = set.Insert(hint, key);
+        if (state.range(1) == 0) hint = set.End();
+      } else {
+        set.Insert(key);
+      }
+    }
+    benchmark::DoNotOptimize(set.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SetInsertOrder, false)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1, 2}});
+BENCHMARK_TEMPLATE(BM_SetInsertOrder, true)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1, 2}});
+
+template <typename MapType>
+static void BM_InsertHeavy(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  for (auto _ : state) {
+    MapType map;
+    for (int key : keys) {
+      map.insert({key, key});
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename MapType>
+static void BM_Churn(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(2 * n);
+  MapType map;
+  for (std::size_t i = 0; i < n; ++i) {
+    map.insert({keys[i], keys[i]});
+  }
+  std::size_t out = 0;
+  std::size_t in = n;
+  for (auto _ : state) {
+    map.erase(keys[out]);
+    map.insert({keys[in], keys[in]});
+    out = (out + 1) % keys.size();
+    in = (in + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// An empty container built, moved once and dropped, as happens to the many
+// short-lived maps and lists that never get an element.
+template <typename ContainerType>
+static void BM_EmptyLifetime(benchmark::State& state) {
+  for (auto _ : state) {
+    ContainerType container;
+    ContainerType moved(std::move(container));
+    benchmark::DoNotOptimize(moved);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_EmptyLifetime, std::map<int, int>);
+BENCHMARK_TEMPLATE(BM_EmptyLifetime, s21::Map<int, int>);
+BENCHMARK_TEMPLATE(BM_EmptyLifetime, std::list<int>);
+BENCHMARK_TEMPLATE(BM_EmptyLifetime, s21::List<int>);
+
+// Red-black Map against BTreeMap and FlatMap through their shared
+// interface, from 1K to 100M elements. The largest sizes need several
+// gigabytes for Map.
+template <typename MapType>
+static void Fill(MapType& map, const std::vector<int>& keys) {
+  for (int key : keys) {
+    map.Insert(key, key);
+  }
+}
+
+// One element at a time would shift the arrays n times, so FlatMap gets
+// the whole batch at once.
+static void Fill(s21::FlatMap<int, int>& map, const std::vector<int>& keys) {
+  std::vector<std::pair<const int, int>> batch;
+  batch.reserve(keys.size());
+  for (int key : keys) {
+    batch.emplace_back(key, key);
+  }
+  map.Insert(batch.begin(), batch.end());
+}
+
+template <typename MapType>
+static void BM_OrderedFind(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  MapType map;
+  Fill(map, keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.Find(keys[i]));
+    if (++i == n) i = 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename MapType>
+static void BM_OrderedInsert(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  for (auto _ : state) {
+    MapType map;
+    Fill(map, keys);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename MapType>
+static void BM_OrderedScan(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  MapType map;
+  Fill(map, ShuffledKeys(n));
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = map.Begin(); it != map.End(); ++it) {
+      sum += it.GetVal();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_OrderedFind, s21::Map<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedFind, s21::BTreeMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedInsert, s21::Map<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedInsert, s21::BTreeMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedScan, s21::Map<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedScan, s21::BTreeMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedFind, s21::FlatMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedInsert, s21::FlatMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_OrderedScan, s21::FlatMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+
+template <typename MapType>
+static void BM_PointFind(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(n);
+  MapType map;
+  for (int key : keys) {
+    map.insert({key, key});
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(keys[i]));
+    if (++i == n) i = 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Adapters giving the s21 maps the std::map spelling used by the templates
+// above.
+class S21Map : public s21::Map<int, int> {
+ public:
+  void insert(const std::pair<const int, int>& value) { Insert(value); }
+  void erase(int key) { Erase(Find(key)); }
+  iterator find(int key) const { return Find(key); }
+};
+
+class S21ReservedMap : public S21Map {
+ public:
+  S21ReservedMap() { Reserve(1 << 20); }
+};
+
+class S21UnorderedMap : public s21::UnorderedMap<int, int> {
+ public:
+  void insert(const std::pair<const int, int>& value) { Insert(value); }
+  void erase(int key) { Erase(Find(key)); }
+  iterator find(int key) const { return Find(key); }
+};
+
+class S21ReservedUnorderedMap : public S21UnorderedMap {
+ public:
+  S21ReservedUnorderedMap() { Reserve(1 << 20); }
+};
+
+BENCHMARK_TEMPLATE(BM_InsertHeavy, std::map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertHeavy, S21Map)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertHeavy, S21ReservedMap)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Churn, std::map<int, int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Churn, S21Map)->Range(1 << 10, 1 << 20);
+
+// Point lookups, inserts and erase-insert churn on the hash table against
+// Map and std::unordered_map.
+BENCHMARK_TEMPLATE(BM_PointFind, S21Map)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_PointFind, std::unordered_map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_PointFind, S21UnorderedMap)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_InsertHeavy, std::unordered_map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertHeavy, S21UnorderedMap)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertHeavy, S21ReservedUnorderedMap)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Churn, std::unordered_map<int, int>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Churn, S21UnorderedMap)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
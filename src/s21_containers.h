@@ -1,12 +1,21 @@
 #ifndef SRC_S21_CONTAINERS_H_
 #define SRC_S21_CONTAINERS_H_
 
+#include "s21_containers/btree_map/btree_map.h"
+#include "s21_containers/btree_set/btree_set.h"
+#include "s21_containers/flat_map/flat_map.h"
+#include "s21_containers/flat_set/flat_set.h"
 #include "s21_containers/general_structures/container.h"
+#include "s21_containers/general_structures/reclaimer.h"
 #include "s21_containers/list/list.h"
 #include "s21_containers/map/map.h"
+#include "s21_containers/multimap/multimap.h"
+#include "s21_containers/multiset/multiset.h"
 #include "s21_containers/queue/queue.h"
 #include "s21_containers/set/set.h"
 #include "s21_containers/stack/stack.h"
+#include "s21_containers/unordered_map/unordered_map.h"
+#include "s21_containers/unordered_set/unordered_set.h"
 #include "s21_containers/vector/vector.h"
 
 #endif  // SRC_S21_CONTAINERS_H_
\ No newline at end of file
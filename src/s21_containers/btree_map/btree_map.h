@@ -0,0 +1,197 @@
+#ifndef SRC_S21_CONTAINERS_BTREE_MAP_BTREE_MAP_H_
+#define SRC_S21_CONTAINERS_BTREE_MAP_BTREE_MAP_H_
+
+#include "../general_structures/btree.h"
+
+namespace s21 {
+
+// Map on a B-tree: the same interface without hints, node handles, set
+// operations or augmentation. Lookups and in-order scans touch far fewer
+// cache lines, but iterators do not survive insertion or erasure.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class BTreeMap : public BTree<Key, T, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename BTree<Key, T, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename BTree<Key, T, Compare, Allocator>::const_iterator;
+  using size_type = typename BTree<Key, T, Compare, Allocator>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  BTreeMap() noexcept = default;
+  explicit BTreeMap(const Allocator& alloc) noexcept
+      : BTree<Key, T, Compare, Allocator>(alloc) {}
+  explicit BTreeMap(const Compare& comp,
+                    const Allocator& alloc = Allocator()) noexcept
+      : BTree<Key, T, Compare, Allocator>(comp, alloc) {}
+  BTreeMap(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : BTreeMap(items.begin(), items.end(), comp, alloc) {}
+  BTreeMap(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : BTreeMap(items, Compare(), alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  BTreeMap(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : BTreeMap(comp, alloc) {
+    for (; first != last; ++first) {
+      Insert(*first);
+    }
+  }
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  BTreeMap(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : BTreeMap(first, last, Compare(), alloc) {}
+  BTreeMap(const BTreeMap& other) = default;
+  BTreeMap(BTreeMap&& other) noexcept = default;
+  ~BTreeMap() = default;
+  BTreeMap& operator=(BTreeMap&& other) noexcept = default;
+  BTreeMap& operator=(const BTreeMap& other) = default;
+
+  std::pair<iterator, bool> Insert(const value_type& value) {
+    return TryEmplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> Insert(value_type&& value) {
+    return TryEmplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> Insert(const Key& key, const T& obj) {
+    return TryEmplace(key, obj);
+  }
+
+  // Constructs the element in place from (key, obj), a pair, or a
+  // piecewise_construct pair of tuples. The key is built first when it is
+  // not given as a Key, since a B-tree has no node to build it in ahead of
+  // the lookup.
+  template <typename K, typename M>
+  std::pair<iterator, bool> Emplace(K&& key, M&& obj) {
+    if constexpr (std::is_same_v<std::decay_t<K>, Key>) {
+      return EmplaceUnique(key, std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    } else {
+      Key built(std::forward<K>(key));
+      return EmplaceUnique(built, std::forward_as_tuple(std::move(built)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    }
+  }
+
+  template <typename P>
+  std::pair<iterator, bool> Emplace(P&& value) {
+    return Emplace(std::get<0>(std::forward<P>(value)),
+                   std::get<1>(std::forward<P>(value)));
+  }
+
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> Emplace(std::piecewise_construct_t,
+                                    std::tuple<KeyArgs...> key_args,
+                                    std::tuple<ValArgs...> val_args) {
+    Key built = std::make_from_tuple<Key>(std::move(key_args));
+    return EmplaceUnique(built, std::forward_as_tuple(std::move(built)),
+                         std::move(val_args));
+  }
+
+  // Inserts a value built from args only if key is missing; otherwise args
+  // are left untouched.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+    return EmplaceUnique(key, std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+    return EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // As in Map, second tells whether a new element was inserted.
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(const Key& key, M&& obj) {
+    auto result = TryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(Key&& key, M&& obj) {
+    auto result = TryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  // second is also true when an existing element got a different value.
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    auto result = TryEmplace(key, obj);
+    if (!result.second && ValueAt(result.first) != obj) {
+      ValueAt(result.first) = obj;
+      result.second = true;
+    }
+    return result;
+  }
+
+  using BTree<Key, T, Compare, Allocator>::Begin;
+  using BTree<Key, T, Compare, Allocator>::End;
+  using BTree<Key, T, Compare, Allocator>::CBegin;
+  using BTree<Key, T, Compare, Allocator>::CEnd;
+
+  using BTree<Key, T, Compare, Allocator>::Merge;
+  using BTree<Key, T, Compare, Allocator>::Clear;
+  using BTree<Key, T, Compare, Allocator>::Swap;
+  using BTree<Key, T, Compare, Allocator>::Erase;
+
+  using BTree<Key, T, Compare, Allocator>::Find;
+  using BTree<Key, T, Compare, Allocator>::Contains;
+  using BTree<Key, T, Compare, Allocator>::Count;
+  using BTree<Key, T, Compare, Allocator>::LowerBound;
+  using BTree<Key, T, Compare, Allocator>::UpperBound;
+  using BTree<Key, T, Compare, Allocator>::EqualRange;
+
+  using BTree<Key, T, Compare, Allocator>::Empty;
+  using BTree<Key, T, Compare, Allocator>::Size;
+  using BTree<Key, T, Compare, Allocator>::MaxSize;
+  using BTree<Key, T, Compare, Allocator>::GetAllocator;
+  using BTree<Key, T, Compare, Allocator>::KeyComp;
+  using BTree<Key, T, Compare, Allocator>::Height;
+
+  T& At(const Key& key) {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in BTreeMap");
+    }
+    return ValueAt(it);
+  }
+  const T& At(const Key& key) const {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in BTreeMap");
+    }
+    return it.GetVal();
+  }
+  T& operator[](const Key& key) { return ValueAt(TryEmplace(key).first); }
+  T& operator[](Key&& key) {
+    return ValueAt(TryEmplace(std::move(key)).first);
+  }
+
+ private:
+  using BTree<Key, T, Compare, Allocator>::EmplaceUnique;
+  using BTree<Key, T, Compare, Allocator>::ValueAt;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_BTREE_MAP_BTREE_MAP_H_
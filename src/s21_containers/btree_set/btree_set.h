@@ -0,0 +1,111 @@
+#ifndef SRC_S21_CONTAINERS_BTREE_SET_BTREE_SET_H_
+#define SRC_S21_CONTAINERS_BTREE_SET_BTREE_SET_H_
+
+#include "../general_structures/btree.h"
+
+namespace s21 {
+
+// Set on a B-tree; see BTreeMap for what it leaves out.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class BTreeSet : public BTree<Key, void, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename BTree<Key, void, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename BTree<Key, void, Compare, Allocator>::const_iterator;
+  using size_type = typename BTree<Key, void, Compare, Allocator>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  BTreeSet() noexcept = default;
+  explicit BTreeSet(const Allocator& alloc) noexcept
+      : BTree<Key, void, Compare, Allocator>(alloc) {}
+  explicit BTreeSet(const Compare& comp,
+                    const Allocator& alloc = Allocator()) noexcept
+      : BTree<Key, void, Compare, Allocator>(comp, alloc) {}
+  BTreeSet(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : BTreeSet(items.begin(), items.end(), comp, alloc) {}
+  BTreeSet(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : BTreeSet(items, Compare(), alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  BTreeSet(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : BTreeSet(comp, alloc) {
+    for (; first != last; ++first) {
+      Insert(*first);
+    }
+  }
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  BTreeSet(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : BTreeSet(first, last, Compare(), alloc) {}
+  BTreeSet(const BTreeSet& other) = default;
+  BTreeSet(BTreeSet&& other) noexcept = default;
+  ~BTreeSet() = default;
+  BTreeSet& operator=(BTreeSet&& other) noexcept = default;
+  BTreeSet& operator=(const BTreeSet& other) = default;
+
+  std::pair<iterator, bool> Insert(const Key& key) {
+    return EmplaceUnique(key, std::forward_as_tuple(key), std::tuple<>());
+  }
+
+  std::pair<iterator, bool> Insert(Key&& key) {
+    return EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                         std::tuple<>());
+  }
+
+  // Builds the key from args, then inserts it unless it is present. A
+  // single Key argument is looked up without building anything.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same_v<std::decay_t<Args>, Key> && ...)) {
+      return EmplaceUnique(args...,
+                           std::forward_as_tuple(std::forward<Args>(args)...),
+                           std::tuple<>());
+    } else {
+      Key built(std::forward<Args>(args)...);
+      return Insert(std::move(built));
+    }
+  }
+
+  using BTree<Key, void, Compare, Allocator>::Begin;
+  using BTree<Key, void, Compare, Allocator>::End;
+  using BTree<Key, void, Compare, Allocator>::CBegin;
+  using BTree<Key, void, Compare, Allocator>::CEnd;
+
+  using BTree<Key, void, Compare, Allocator>::Clear;
+  using BTree<Key, void, Compare, Allocator>::Merge;
+  using BTree<Key, void, Compare, Allocator>::Swap;
+  using BTree<Key, void, Compare, Allocator>::Erase;
+
+  using BTree<Key, void, Compare, Allocator>::Find;
+  using BTree<Key, void, Compare, Allocator>::Contains;
+  using BTree<Key, void, Compare, Allocator>::Count;
+  using BTree<Key, void, Compare, Allocator>::LowerBound;
+  using BTree<Key, void, Compare, Allocator>::UpperBound;
+  using BTree<Key, void, Compare, Allocator>::EqualRange;
+
+  using BTree<Key, void, Compare, Allocator>::Empty;
+  using BTree<Key, void, Compare, Allocator>::Size;
+  using BTree<Key, void, Compare, Allocator>::MaxSize;
+  using BTree<Key, void, Compare, Allocator>::GetAllocator;
+  using BTree<Key, void, Compare, Allocator>::KeyComp;
+  using BTree<Key, void, Compare, Allocator>::Height;
+
+ private:
+  using BTree<Key, void, Compare, Allocator>::EmplaceUnique;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_BTREE_SET_BTREE_SET_H_
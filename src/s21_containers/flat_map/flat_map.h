@@ -0,0 +1,218 @@
+#ifndef SRC_S21_CONTAINERS_FLAT_MAP_FLAT_MAP_H_
+#define SRC_S21_CONTAINERS_FLAT_MAP_FLAT_MAP_H_
+
+#include "../general_structures/flat_container.h"
+
+namespace s21 {
+
+// Map on sorted key and value Vectors, for maps built once and read many
+// times. It has the Map interface without hints, node handles, set
+// operations or augmentation, plus Insert(first, last) and Replace for
+// building in bulk. Iterators do not survive insertion or erasure.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class FlatMap : public FlatContainer<Key, T, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename FlatContainer<Key, T, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename FlatContainer<Key, T, Compare, Allocator>::const_iterator;
+  using size_type =
+      typename FlatContainer<Key, T, Compare, Allocator>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container =
+      typename FlatContainer<Key, T, Compare, Allocator>::key_container;
+  using mapped_container =
+      typename FlatContainer<Key, T, Compare, Allocator>::mapped_container;
+
+  FlatMap() noexcept = default;
+  explicit FlatMap(const Allocator& alloc) noexcept
+      : FlatContainer<Key, T, Compare, Allocator>(alloc) {}
+  explicit FlatMap(const Compare& comp,
+                   const Allocator& alloc = Allocator()) noexcept
+      : FlatContainer<Key, T, Compare, Allocator>(comp, alloc) {}
+  FlatMap(std::initializer_list<value_type> const& items,
+          const Compare& comp = Compare(),
+          const Allocator& alloc = Allocator())
+      : FlatMap(items.begin(), items.end(), comp, alloc) {}
+  FlatMap(std::initializer_list<value_type> const& items,
+          const Allocator& alloc)
+      : FlatMap(items, Compare(), alloc) {}
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  FlatMap(InputIt first, InputIt last, const Compare& comp = Compare(),
+          const Allocator& alloc = Allocator())
+      : FlatMap(comp, alloc) {
+    InsertRange(first, last);
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  FlatMap(InputIt first, InputIt last, const Allocator& alloc)
+      : FlatMap(first, last, Compare(), alloc) {}
+  // Adopts the arrays as Replace does.
+  FlatMap(key_container&& keys, mapped_container&& vals,
+          const Compare& comp = Compare(),
+          const Allocator& alloc = Allocator())
+      : FlatMap(comp, alloc) {
+    Replace(std::move(keys), std::move(vals));
+  }
+  FlatMap(const FlatMap& other) = default;
+  FlatMap(FlatMap&& other) = default;
+  ~FlatMap() = default;
+  FlatMap& operator=(FlatMap&& other) = default;
+  FlatMap& operator=(const FlatMap& other) = default;
+
+  std::pair<iterator, bool> Insert(const value_type& value) {
+    return TryEmplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> Insert(value_type&& value) {
+    return TryEmplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> Insert(const Key& key, const T& obj) {
+    return TryEmplace(key, obj);
+  }
+
+  // Sorts the batch and merges it with the arrays in one pass, so it costs
+  // O(n + k log k) instead of k shifts of the arrays.
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  void Insert(InputIt first, InputIt last) {
+    InsertRange(first, last);
+  }
+
+  void Insert(std::initializer_list<value_type> const& items) {
+    InsertRange(items.begin(), items.end());
+  }
+
+  // Builds the element from (key, obj), a pair, or a piecewise_construct
+  // pair of tuples. A key not given as a Key is built first to be looked
+  // up.
+  template <typename K, typename M>
+  std::pair<iterator, bool> Emplace(K&& key, M&& obj) {
+    if constexpr (std::is_same_v<std::decay_t<K>, Key>) {
+      return EmplaceUnique(std::forward<K>(key), std::forward<M>(obj));
+    } else {
+      return EmplaceUnique(Key(std::forward<K>(key)), std::forward<M>(obj));
+    }
+  }
+
+  template <typename P>
+  std::pair<iterator, bool> Emplace(P&& value) {
+    return Emplace(std::get<0>(std::forward<P>(value)),
+                   std::get<1>(std::forward<P>(value)));
+  }
+
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> Emplace(std::piecewise_construct_t,
+                                    std::tuple<KeyArgs...> key_args,
+                                    std::tuple<ValArgs...> val_args) {
+    return EmplaceUnique(std::make_from_tuple<Key>(std::move(key_args)),
+                         std::make_from_tuple<T>(std::move(val_args)));
+  }
+
+  // Inserts a value built from args only if key is missing; otherwise args
+  // are left untouched.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+    return EmplaceUnique(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+    return EmplaceUnique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  // As in Map, second tells whether a new element was inserted.
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(const Key& key, M&& obj) {
+    auto result = TryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(Key&& key, M&& obj) {
+    auto result = TryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  // second is also true when an existing element got a different value.
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    auto result = TryEmplace(key, obj);
+    if (!result.second && ValueAt(result.first) != obj) {
+      ValueAt(result.first) = obj;
+      result.second = true;
+    }
+    return result;
+  }
+
+  using FlatContainer<Key, T, Compare, Allocator>::Replace;
+
+  using FlatContainer<Key, T, Compare, Allocator>::Begin;
+  using FlatContainer<Key, T, Compare, Allocator>::End;
+  using FlatContainer<Key, T, Compare, Allocator>::CBegin;
+  using FlatContainer<Key, T, Compare, Allocator>::CEnd;
+
+  using FlatContainer<Key, T, Compare, Allocator>::Merge;
+  using FlatContainer<Key, T, Compare, Allocator>::Clear;
+  using FlatContainer<Key, T, Compare, Allocator>::Swap;
+  using FlatContainer<Key, T, Compare, Allocator>::Erase;
+
+  using FlatContainer<Key, T, Compare, Allocator>::Find;
+  using FlatContainer<Key, T, Compare, Allocator>::Contains;
+  using FlatContainer<Key, T, Compare, Allocator>::Count;
+  using FlatContainer<Key, T, Compare, Allocator>::LowerBound;
+  using FlatContainer<Key, T, Compare, Allocator>::UpperBound;
+  using FlatContainer<Key, T, Compare, Allocator>::EqualRange;
+
+  using FlatContainer<Key, T, Compare, Allocator>::Empty;
+  using FlatContainer<Key, T, Compare, Allocator>::Size;
+  using FlatContainer<Key, T, Compare, Allocator>::MaxSize;
+  using FlatContainer<Key, T, Compare, Allocator>::Reserve;
+  using FlatContainer<Key, T, Compare, Allocator>::GetAllocator;
+  using FlatContainer<Key, T, Compare, Allocator>::KeyComp;
+
+  T& At(const Key& key) {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in FlatMap");
+    }
+    return ValueAt(it);
+  }
+  const T& At(const Key& key) const {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in FlatMap");
+    }
+    return it.GetVal();
+  }
+  T& operator[](const Key& key) { return ValueAt(TryEmplace(key).first); }
+  T& operator[](Key&& key) {
+    return ValueAt(TryEmplace(std::move(key)).first);
+  }
+
+ private:
+  using FlatContainer<Key, T, Compare, Allocator>::EmplaceUnique;
+  using FlatContainer<Key, T, Compare, Allocator>::InsertRange;
+  using FlatContainer<Key, T, Compare, Allocator>::ValueAt;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_FLAT_MAP_FLAT_MAP_H_
@@ -0,0 +1,133 @@
+#ifndef SRC_S21_CONTAINERS_FLAT_SET_FLAT_SET_H_
+#define SRC_S21_CONTAINERS_FLAT_SET_FLAT_SET_H_
+
+#include "../general_structures/flat_container.h"
+
+namespace s21 {
+
+// Set on a sorted Vector of keys; see FlatMap.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class FlatSet : public FlatContainer<Key, void, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename FlatContainer<Key, void, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename FlatContainer<Key, void, Compare, Allocator>::const_iterator;
+  using size_type =
+      typename FlatContainer<Key, void, Compare, Allocator>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container =
+      typename FlatContainer<Key, void, Compare, Allocator>::key_container;
+
+  FlatSet() noexcept = default;
+  explicit FlatSet(const Allocator& alloc) noexcept
+      : FlatContainer<Key, void, Compare, Allocator>(alloc) {}
+  explicit FlatSet(const Compare& comp,
+                   const Allocator& alloc = Allocator()) noexcept
+      : FlatContainer<Key, void, Compare, Allocator>(comp, alloc) {}
+  FlatSet(std::initializer_list<value_type> const& items,
+          const Compare& comp = Compare(),
+          const Allocator& alloc = Allocator())
+      : FlatSet(items.begin(), items.end(), comp, alloc) {}
+  FlatSet(std::initializer_list<value_type> const& items,
+          const Allocator& alloc)
+      : FlatSet(items, Compare(), alloc) {}
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  FlatSet(InputIt first, InputIt last, const Compare& comp = Compare(),
+          const Allocator& alloc = Allocator())
+      : FlatSet(comp, alloc) {
+    InsertRange(first, last);
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  FlatSet(InputIt first, InputIt last, const Allocator& alloc)
+      : FlatSet(first, last, Compare(), alloc) {}
+  // Adopts keys as Replace does.
+  explicit FlatSet(key_container&& keys, const Compare& comp = Compare(),
+                   const Allocator& alloc = Allocator())
+      : FlatSet(comp, alloc) {
+    Replace(std::move(keys));
+  }
+  FlatSet(const FlatSet& other) = default;
+  FlatSet(FlatSet&& other) = default;
+  ~FlatSet() = default;
+  FlatSet& operator=(FlatSet&& other) = default;
+  FlatSet& operator=(const FlatSet& other) = default;
+
+  std::pair<iterator, bool> Insert(const Key& key) {
+    return EmplaceUnique(key);
+  }
+
+  std::pair<iterator, bool> Insert(Key&& key) {
+    return EmplaceUnique(std::move(key));
+  }
+
+  // Sorts the batch and merges it with the keys in one pass.
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  void Insert(InputIt first, InputIt last) {
+    InsertRange(first, last);
+  }
+
+  void Insert(std::initializer_list<value_type> const& items) {
+    InsertRange(items.begin(), items.end());
+  }
+
+  // Builds the key from args, then inserts it unless it is present.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same_v<std::decay_t<Args>, Key> && ...)) {
+      return EmplaceUnique(std::forward<Args>(args)...);
+    } else {
+      return EmplaceUnique(Key(std::forward<Args>(args)...));
+    }
+  }
+
+  // Takes over keys as the contents; see FlatContainer::Replace.
+  void Replace(key_container&& keys) {
+    FlatContainer<Key, void, Compare, Allocator>::Replace(std::move(keys),
+                                                          FlatNoValues());
+  }
+
+  using FlatContainer<Key, void, Compare, Allocator>::Begin;
+  using FlatContainer<Key, void, Compare, Allocator>::End;
+  using FlatContainer<Key, void, Compare, Allocator>::CBegin;
+  using FlatContainer<Key, void, Compare, Allocator>::CEnd;
+
+  using FlatContainer<Key, void, Compare, Allocator>::Clear;
+  using FlatContainer<Key, void, Compare, Allocator>::Merge;
+  using FlatContainer<Key, void, Compare, Allocator>::Swap;
+  using FlatContainer<Key, void, Compare, Allocator>::Erase;
+
+  using FlatContainer<Key, void, Compare, Allocator>::Find;
+  using FlatContainer<Key, void, Compare, Allocator>::Contains;
+  using FlatContainer<Key, void, Compare, Allocator>::Count;
+  using FlatContainer<Key, void, Compare, Allocator>::LowerBound;
+  using FlatContainer<Key, void, Compare, Allocator>::UpperBound;
+  using FlatContainer<Key, void, Compare, Allocator>::EqualRange;
+
+  using FlatContainer<Key, void, Compare, Allocator>::Empty;
+  using FlatContainer<Key, void, Compare, Allocator>::Size;
+  using FlatContainer<Key, void, Compare, Allocator>::MaxSize;
+  using FlatContainer<Key, void, Compare, Allocator>::Reserve;
+  using FlatContainer<Key, void, Compare, Allocator>::GetAllocator;
+  using FlatContainer<Key, void, Compare, Allocator>::KeyComp;
+
+ private:
+  using FlatContainer<Key, void, Compare, Allocator>::EmplaceUnique;
+  using FlatContainer<Key, void, Compare, Allocator>::InsertRange;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_FLAT_SET_FLAT_SET_H_
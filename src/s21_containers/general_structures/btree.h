@@ -0,0 +1,165 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "btree_iter.h"
+#include "btree_node.h"
+#include "node.h"
+
+namespace s21 {
+
+// B-tree behind BTreeMap and BTreeSet. Each node keeps up to kCapacity
+// elements in sorted arrays, see kBTreeNodeBytes, and every node but the
+// root at least kMinCount. Elements live in inner nodes too, so a lookup
+// can stop early, and all leaves are at the same depth. A set has
+// T = void and stores keys only.
+//
+// Unlike in Container, elements move between nodes when the tree changes
+// shape: every insertion and erasure invalidates all iterators.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class BTree {
+ public:
+  static constexpr int kCapacity = BTreeCapacity<Key, T>();
+  static constexpr int kMinCount = (kCapacity - 1) / 2;
+
+  using key_type = Key;
+  using iterator = BTreeIter<Key, T, kCapacity>;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  BTree() noexcept;
+  explicit BTree(const Allocator& alloc) noexcept;
+  explicit BTree(const Compare& comp,
+                 const Allocator& alloc = Allocator()) noexcept;
+  BTree(const BTree& other);
+  BTree(const BTree& other, const Allocator& alloc);
+  BTree(BTree&& other) noexcept;
+  ~BTree();
+
+  BTree& operator=(const BTree& other);
+  BTree& operator=(BTree&& other) noexcept;
+
+  iterator Begin() const noexcept;
+  iterator End() const noexcept;
+  const_iterator CBegin() const noexcept;
+  const_iterator CEnd() const noexcept;
+
+  bool Empty() const noexcept;
+  size_type Size() const noexcept;
+  size_type MaxSize() const noexcept;
+  allocator_type GetAllocator() const noexcept;
+  key_compare KeyComp() const;
+
+  void Clear() noexcept;
+  void Swap(BTree& other) noexcept;
+  // Moves over the elements of other whose keys are missing here; the
+  // others stay in other.
+  void Merge(BTree& other);
+
+  void Erase(iterator pos);
+  // Erases the elements one at a time, finding the next one again after
+  // each erasure, so it needs a copy of the key at last.
+  void Erase(iterator first, iterator last);
+
+  iterator Find(const Key& key) const;
+  bool Contains(const Key& key) const;
+  size_type Count(const Key& key) const;
+  // First element whose key is not less than key, or End().
+  iterator LowerBound(const Key& key) const;
+  // First element whose key is greater than key, or End().
+  iterator UpperBound(const Key& key) const;
+  std::pair<iterator, iterator> EqualRange(const Key& key) const;
+
+  // Number of levels, 0 for an empty tree.
+  int Height() const noexcept;
+
+ protected:
+  using node_type = BTreeNode<Key, T, kCapacity>;
+  using inner_type = BTreeInner<Key, T, kCapacity>;
+
+  // Builds an element from the two tuples unless key is already present,
+  // in which case the tuples are left untouched. val_args is ignored by a
+  // set.
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> EmplaceUnique(const Key& key,
+                                          std::tuple<KeyArgs...> key_args,
+                                          std::tuple<ValArgs...> val_args);
+  template <typename V = T>
+  static V& ValueAt(iterator pos) noexcept {
+    return pos.GetNode()->Vals()[pos.GetPosition()];
+  }
+
+ private:
+  using leaf_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node_type>;
+  using inner_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<inner_type>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using inner_traits = std::allocator_traits<inner_allocator>;
+
+  static node_type*& Child(node_type* node, int index) noexcept;
+  node_type* NewNode(bool leaf);
+  void FreeNode(node_type* node) noexcept;
+  void FreeTree(node_type* node) noexcept;
+  node_type* CloneTree(const node_type* source, node_type* parent);
+
+  // First slot of node whose key is not less than key.
+  int LowerSlot(const node_type* node, const Key& key) const;
+  static void Destroy(node_type* node, int slot) noexcept;
+  // Move-constructs slot to_slot of to from slot from_slot of from, which
+  // then ends its lifetime.
+  static void Transfer(node_type* to, int to_slot, node_type* from,
+                       int from_slot) noexcept;
+  // Moves the element at source, in another tree, into target unless its
+  // key is already there.
+  static void MoveInto(BTree& target, iterator source);
+  // Sets child index of inner node parent.
+  static void Adopt(node_type* parent, int index, node_type* child) noexcept;
+
+  // Makes room in a full node by moving its upper half to a new right
+  // sibling and its middle element up, splitting the parent first when
+  // that is full too.
+  void SplitNode(node_type* node);
+  // Builds an element in slot of leaf, which must have room.
+  template <typename... KeyArgs, typename... ValArgs>
+  void InsertAt(node_type* leaf, int slot, std::tuple<KeyArgs...>& key_args,
+                std::tuple<ValArgs...>& val_args);
+  // Restores kMinCount from node upwards by borrowing from a sibling or
+  // merging with one.
+  void Rebalance(node_type* node) noexcept;
+  // Moves the last element of child index - 1 through separator index - 1
+  // of parent into child index, or the other way round for RotateLeft.
+  static void RotateRight(node_type* parent, int index) noexcept;
+  static void RotateLeft(node_type* parent, int index) noexcept;
+  // Joins child index + 1 and separator index of parent into child index.
+  void MergeChildren(node_type* parent, int index) noexcept;
+
+  node_type* root_;
+  // Ends of the tree, kept for O(1) Begin() and End().
+  node_type* leftmost_;
+  node_type* rightmost_;
+  size_type size_;
+  leaf_allocator leaf_alloc_;
+  inner_allocator inner_alloc_;
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#include "btree.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_H_
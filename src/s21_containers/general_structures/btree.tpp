@@ -0,0 +1,693 @@
+#include "btree.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree() noexcept
+    : BTree(Compare(), Allocator()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree(const Allocator& alloc) noexcept
+    : BTree(Compare(), alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree(const Compare& comp,
+                                         const Allocator& alloc) noexcept
+    : root_(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      size_(0),
+      leaf_alloc_(alloc),
+      inner_alloc_(alloc),
+      comp_(comp) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree(const BTree& other)
+    : BTree(other, std::allocator_traits<Allocator>::
+                       select_on_container_copy_construction(
+                           other.GetAllocator())) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree(const BTree& other,
+                                         const Allocator& alloc)
+    : BTree(other.comp_, alloc) {
+  if (other.root_ == nullptr) {
+    return;
+  }
+  root_ = CloneTree(other.root_, nullptr);
+  size_ = other.size_;
+  leftmost_ = root_;
+  while (!leftmost_->leaf_) {
+    leftmost_ = Child(leftmost_, 0);
+  }
+  rightmost_ = root_;
+  while (!rightmost_->leaf_) {
+    rightmost_ = Child(rightmost_, rightmost_->count_);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::BTree(BTree&& other) noexcept
+    : root_(other.root_),
+      leftmost_(other.leftmost_),
+      rightmost_(other.rightmost_),
+      size_(other.size_),
+      leaf_alloc_(std::move(other.leaf_alloc_)),
+      inner_alloc_(std::move(other.inner_alloc_)),
+      comp_(std::move(other.comp_)) {
+  other.root_ = nullptr;
+  other.leftmost_ = nullptr;
+  other.rightmost_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>::~BTree() {
+  Clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>& BTree<Key, T, Compare, Allocator>::operator=(
+    const BTree& other) {
+  if (this != &other) {
+    BTree<Key, T, Compare, Allocator> temp(
+        other, std::allocator_traits<
+                   Allocator>::propagate_on_container_copy_assignment::value
+                   ? other.GetAllocator()
+                   : GetAllocator());
+    Swap(temp);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+BTree<Key, T, Compare, Allocator>& BTree<Key, T, Compare, Allocator>::operator=(
+    BTree&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  Clear();
+  if (!std::allocator_traits<
+          Allocator>::propagate_on_container_move_assignment::value &&
+      GetAllocator() != other.GetAllocator()) {
+    // Our allocator stays and cannot free other's nodes.
+    comp_ = other.comp_;
+    for (iterator it = other.Begin(); it != other.End(); ++it) {
+      MoveInto(*this, it);
+    }
+    other.Clear();
+  } else {
+    leaf_alloc_ = std::move(other.leaf_alloc_);
+    inner_alloc_ = std::move(other.inner_alloc_);
+    comp_ = std::move(other.comp_);
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(size_, other.size_);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::iterator
+BTree<Key, T, Compare, Allocator>::Begin() const noexcept {
+  return leftmost_ == nullptr ? iterator() : iterator(leftmost_, 0);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::iterator
+BTree<Key, T, Compare, Allocator>::End() const noexcept {
+  return rightmost_ == nullptr ? iterator()
+                               : iterator(rightmost_, rightmost_->count_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::const_iterator
+BTree<Key, T, Compare, Allocator>::CBegin() const noexcept {
+  return Begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::const_iterator
+BTree<Key, T, Compare, Allocator>::CEnd() const noexcept {
+  return End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool BTree<Key, T, Compare, Allocator>::Empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::size_type
+BTree<Key, T, Compare, Allocator>::Size() const noexcept {
+  return size_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::size_type
+BTree<Key, T, Compare, Allocator>::MaxSize() const noexcept {
+  return leaf_traits::max_size(leaf_alloc_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::allocator_type
+BTree<Key, T, Compare, Allocator>::GetAllocator() const noexcept {
+  return Allocator(leaf_alloc_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::key_compare
+BTree<Key, T, Compare, Allocator>::KeyComp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Clear() noexcept {
+  FreeTree(root_);
+  root_ = nullptr;
+  leftmost_ = nullptr;
+  rightmost_ = nullptr;
+  size_ = 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Swap(BTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+  std::swap(leaf_alloc_, other.leaf_alloc_);
+  std::swap(inner_alloc_, other.inner_alloc_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Merge(BTree& other) {
+  if (this == &other) {
+    return;
+  }
+  // Erasing from other would break the walk over it, so the elements that
+  // stay are moved, in order, into a fresh tree that then replaces it.
+  BTree<Key, T, Compare, Allocator> kept(other.comp_, other.GetAllocator());
+  for (iterator it = other.Begin(); it != other.End(); ++it) {
+    MoveInto(Contains(it.GetKey()) ? kept : *this, it);
+  }
+  other.Swap(kept);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Erase(iterator pos) {
+  node_type* node = pos.GetNode();
+  int slot = pos.GetPosition();
+  Destroy(node, slot);
+  if (node->leaf_) {
+    for (int i = slot + 1; i < node->count_; ++i) {
+      Transfer(node, i - 1, node, i);
+    }
+  } else {
+    // The predecessor, the last element of the left subtree, fills the
+    // hole, so elements only ever leave leaves.
+    node_type* leaf = Child(node, slot);
+    while (!leaf->leaf_) {
+      leaf = Child(leaf, leaf->count_);
+    }
+    Transfer(node, slot, leaf, leaf->count_ - 1);
+    node = leaf;
+  }
+  --node->count_;
+  --size_;
+  Rebalance(node);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Erase(iterator first, iterator last) {
+  if (first == last) {
+    return;
+  }
+  if (first == Begin() && last == End()) {
+    Clear();
+    return;
+  }
+  size_type count = 0;
+  for (iterator it = first; it != last; ++it) {
+    ++count;
+  }
+  if (last == End()) {
+    for (; count > 0; --count) {
+      iterator it = End();
+      Erase(--it);
+    }
+  } else {
+    Key bound(last.GetKey());
+    for (; count > 0; --count) {
+      iterator it = LowerBound(bound);
+      Erase(--it);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::iterator
+BTree<Key, T, Compare, Allocator>::Find(const Key& key) const {
+  node_type* node = root_;
+  while (node != nullptr) {
+    int slot = LowerSlot(node, key);
+    if (slot < node->count_ && !comp_(key, node->Keys()[slot])) {
+      return iterator(node, slot);
+    }
+    node = node->leaf_ ? nullptr : Child(node, slot);
+  }
+  return End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool BTree<Key, T, Compare, Allocator>::Contains(const Key& key) const {
+  return Find(key) != End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::size_type
+BTree<Key, T, Compare, Allocator>::Count(const Key& key) const {
+  return Contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::iterator
+BTree<Key, T, Compare, Allocator>::LowerBound(const Key& key) const {
+  // Each level can only offer a smaller candidate than the one above.
+  iterator result = End();
+  node_type* node = root_;
+  while (node != nullptr) {
+    int slot = LowerSlot(node, key);
+    if (slot < node->count_) {
+      result = iterator(node, slot);
+      if (!comp_(key, node->Keys()[slot])) {
+        return result;
+      }
+    }
+    node = node->leaf_ ? nullptr : Child(node, slot);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::iterator
+BTree<Key, T, Compare, Allocator>::UpperBound(const Key& key) const {
+  iterator result = End();
+  node_type* node = root_;
+  while (node != nullptr) {
+    const Key* keys = node->Keys();
+    int slot = static_cast<int>(
+        std::upper_bound(keys, keys + node->count_, key, comp_) - keys);
+    if (slot < node->count_) {
+      result = iterator(node, slot);
+    }
+    node = node->leaf_ ? nullptr : Child(node, slot);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename BTree<Key, T, Compare, Allocator>::iterator,
+          typename BTree<Key, T, Compare, Allocator>::iterator>
+BTree<Key, T, Compare, Allocator>::EqualRange(const Key& key) const {
+  iterator first = Find(key);
+  if (first == End()) {
+    first = LowerBound(key);
+    return {first, first};
+  }
+  iterator last = first;
+  return {first, ++last};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int BTree<Key, T, Compare, Allocator>::Height() const noexcept {
+  int height = 0;
+  for (node_type* node = root_; node != nullptr;
+       node = node->leaf_ ? nullptr : Child(node, 0)) {
+    ++height;
+  }
+  return height;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... KeyArgs, typename... ValArgs>
+std::pair<typename BTree<Key, T, Compare, Allocator>::iterator, bool>
+BTree<Key, T, Compare, Allocator>::EmplaceUnique(
+    const Key& key, std::tuple<KeyArgs...> key_args,
+    std::tuple<ValArgs...> val_args) {
+  if (root_ == nullptr) {
+    root_ = NewNode(true);
+    leftmost_ = root_;
+    rightmost_ = root_;
+  }
+  node_type* node = root_;
+  int slot = LowerSlot(node, key);
+  while (true) {
+    if (slot < node->count_ && !comp_(key, node->Keys()[slot])) {
+      return {iterator(node, slot), false};
+    }
+    if (node->leaf_) {
+      break;
+    }
+    node = Child(node, slot);
+    slot = LowerSlot(node, key);
+  }
+  if (node->count_ == kCapacity) {
+    SplitNode(node);
+    constexpr int middle = kCapacity / 2;
+    if (slot > middle) {
+      node = Child(node->parent_, node->position_ + 1);
+      slot -= middle + 1;
+    }
+  }
+  try {
+    InsertAt(node, slot, key_args, val_args);
+  } catch (...) {
+    if (size_ == 0) {
+      Clear();
+    }
+    throw;
+  }
+  ++size_;
+  return {iterator(node, slot), true};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::node_type*&
+BTree<Key, T, Compare, Allocator>::Child(node_type* node, int index) noexcept {
+  return static_cast<inner_type*>(node)->children_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::node_type*
+BTree<Key, T, Compare, Allocator>::NewNode(bool leaf) {
+  node_type* node;
+  if (leaf) {
+    node = ::new (static_cast<void*>(leaf_traits::allocate(leaf_alloc_, 1)))
+        node_type;
+  } else {
+    inner_type* inner = ::new (
+        static_cast<void*>(inner_traits::allocate(inner_alloc_, 1))) inner_type;
+    std::fill(inner->children_, inner->children_ + kCapacity + 1, nullptr);
+    node = inner;
+  }
+  node->parent_ = nullptr;
+  node->position_ = 0;
+  node->count_ = 0;
+  node->leaf_ = leaf;
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::FreeNode(node_type* node) noexcept {
+  if (node->leaf_) {
+    leaf_traits::deallocate(leaf_alloc_, node, 1);
+  } else {
+    inner_traits::deallocate(inner_alloc_, static_cast<inner_type*>(node), 1);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::FreeTree(node_type* node) noexcept {
+  // Recursion is bounded by the height, which stays small.
+  if (node == nullptr) {
+    return;
+  }
+  for (int i = 0; i < node->count_; ++i) {
+    Destroy(node, i);
+  }
+  if (!node->leaf_) {
+    for (int i = 0; i <= node->count_; ++i) {
+      FreeTree(Child(node, i));
+    }
+  }
+  FreeNode(node);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename BTree<Key, T, Compare, Allocator>::node_type*
+BTree<Key, T, Compare, Allocator>::CloneTree(const node_type* source,
+                                             node_type* parent) {
+  node_type* node = NewNode(source->leaf_);
+  node->parent_ = parent;
+  node->position_ = source->position_;
+  try {
+    // count_ grows with every copy and children are null until cloned, so
+    // FreeTree can undo a partial copy.
+    for (int i = 0; i < source->count_; ++i) {
+      ::new (static_cast<void*>(node->Keys() + i)) Key(source->Keys()[i]);
+      if constexpr (!std::is_void_v<T>) {
+        try {
+          ::new (static_cast<void*>(node->Vals() + i)) T(source->Vals()[i]);
+        } catch (...) {
+          node->Keys()[i].~Key();
+          throw;
+        }
+      }
+      ++node->count_;
+    }
+    if (!source->leaf_) {
+      node_type* from = const_cast<node_type*>(source);
+      for (int i = 0; i <= source->count_; ++i) {
+        Child(node, i) = CloneTree(Child(from, i), node);
+      }
+    }
+  } catch (...) {
+    FreeTree(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int BTree<Key, T, Compare, Allocator>::LowerSlot(const node_type* node,
+                                                 const Key& key) const {
+  const Key* keys = node->Keys();
+  return static_cast<int>(
+      std::lower_bound(keys, keys + node->count_, key, comp_) - keys);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Destroy(node_type* node,
+                                                int slot) noexcept {
+  node->Keys()[slot].~Key();
+  if constexpr (!std::is_void_v<T>) {
+    node->Vals()[slot].~T();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Transfer(node_type* to, int to_slot,
+                                                 node_type* from,
+                                                 int from_slot) noexcept {
+  Key& key = from->Keys()[from_slot];
+  ::new (static_cast<void*>(to->Keys() + to_slot)) Key(std::move(key));
+  key.~Key();
+  if constexpr (!std::is_void_v<T>) {
+    T& val = from->Vals()[from_slot];
+    ::new (static_cast<void*>(to->Vals() + to_slot)) T(std::move(val));
+    val.~T();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::MoveInto(BTree& target,
+                                                 iterator source) {
+  node_type* node = source.GetNode();
+  Key& key = node->Keys()[source.GetPosition()];
+  if constexpr (std::is_void_v<T>) {
+    target.EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                         std::tuple<>());
+  } else {
+    target.EmplaceUnique(
+        key, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::move(node->Vals()[source.GetPosition()])));
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Adopt(node_type* parent, int index,
+                                              node_type* child) noexcept {
+  Child(parent, index) = child;
+  child->parent_ = parent;
+  child->position_ = static_cast<unsigned short>(index);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::SplitNode(node_type* node) {
+  node_type* parent = node->parent_;
+  if (parent != nullptr && parent->count_ == kCapacity) {
+    SplitNode(parent);
+    parent = node->parent_;
+  }
+  // Both allocations come before anything moves, so a throw leaves the
+  // tree as it was.
+  node_type* sibling = NewNode(node->leaf_);
+  if (parent == nullptr) {
+    try {
+      parent = NewNode(false);
+    } catch (...) {
+      FreeNode(sibling);
+      throw;
+    }
+    Adopt(parent, 0, node);
+    root_ = parent;
+  }
+  constexpr int middle = kCapacity / 2;
+  int moved = node->count_ - middle - 1;
+  for (int i = 0; i < moved; ++i) {
+    Transfer(sibling, i, node, middle + 1 + i);
+  }
+  if (!node->leaf_) {
+    for (int i = 0; i <= moved; ++i) {
+      Adopt(sibling, i, Child(node, middle + 1 + i));
+    }
+  }
+  sibling->count_ = static_cast<unsigned short>(moved);
+  int index = node->position_;
+  for (int i = parent->count_; i > index; --i) {
+    Transfer(parent, i, parent, i - 1);
+    Adopt(parent, i + 1, Child(parent, i));
+  }
+  Transfer(parent, index, node, middle);
+  Adopt(parent, index + 1, sibling);
+  ++parent->count_;
+  node->count_ = middle;
+  if (rightmost_ == node) {
+    rightmost_ = sibling;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... KeyArgs, typename... ValArgs>
+void BTree<Key, T, Compare, Allocator>::InsertAt(
+    node_type* leaf, int slot, std::tuple<KeyArgs...>& key_args,
+    std::tuple<ValArgs...>& val_args) {
+  for (int i = leaf->count_; i > slot; --i) {
+    Transfer(leaf, i, leaf, i - 1);
+  }
+  try {
+    ConstructAt(leaf->Keys() + slot, std::move(key_args));
+    if constexpr (!std::is_void_v<T>) {
+      try {
+        ConstructAt(leaf->Vals() + slot, std::move(val_args));
+      } catch (...) {
+        leaf->Keys()[slot].~Key();
+        throw;
+      }
+    } else {
+      static_cast<void>(val_args);
+    }
+  } catch (...) {
+    for (int i = slot; i < leaf->count_; ++i) {
+      Transfer(leaf, i, leaf, i + 1);
+    }
+    throw;
+  }
+  ++leaf->count_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::Rebalance(node_type* node) noexcept {
+  while (node != root_ && node->count_ < kMinCount) {
+    node_type* parent = node->parent_;
+    int index = node->position_;
+    if (index > 0 && Child(parent, index - 1)->count_ > kMinCount) {
+      RotateRight(parent, index);
+      return;
+    }
+    if (index < parent->count_ &&
+        Child(parent, index + 1)->count_ > kMinCount) {
+      RotateLeft(parent, index);
+      return;
+    }
+    MergeChildren(parent, index > 0 ? index - 1 : index);
+    node = parent;
+  }
+  if (root_->count_ == 0) {
+    node_type* old_root = root_;
+    if (root_->leaf_) {
+      root_ = nullptr;
+      leftmost_ = nullptr;
+      rightmost_ = nullptr;
+    } else {
+      root_ = Child(root_, 0);
+      root_->parent_ = nullptr;
+      root_->position_ = 0;
+    }
+    FreeNode(old_root);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::RotateRight(node_type* parent,
+                                                    int index) noexcept {
+  node_type* left = Child(parent, index - 1);
+  node_type* right = Child(parent, index);
+  for (int i = right->count_; i > 0; --i) {
+    Transfer(right, i, right, i - 1);
+  }
+  if (!right->leaf_) {
+    for (int i = right->count_ + 1; i > 0; --i) {
+      Adopt(right, i, Child(right, i - 1));
+    }
+    Adopt(right, 0, Child(left, left->count_));
+  }
+  Transfer(right, 0, parent, index - 1);
+  Transfer(parent, index - 1, left, left->count_ - 1);
+  --left->count_;
+  ++right->count_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::RotateLeft(node_type* parent,
+                                                   int index) noexcept {
+  node_type* left = Child(parent, index);
+  node_type* right = Child(parent, index + 1);
+  Transfer(left, left->count_, parent, index);
+  Transfer(parent, index, right, 0);
+  if (!left->leaf_) {
+    Adopt(left, left->count_ + 1, Child(right, 0));
+  }
+  for (int i = 1; i < right->count_; ++i) {
+    Transfer(right, i - 1, right, i);
+  }
+  if (!right->leaf_) {
+    for (int i = 1; i <= right->count_; ++i) {
+      Adopt(right, i - 1, Child(right, i));
+    }
+  }
+  ++left->count_;
+  --right->count_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void BTree<Key, T, Compare, Allocator>::MergeChildren(node_type* parent,
+                                                      int index) noexcept {
+  node_type* left = Child(parent, index);
+  node_type* right = Child(parent, index + 1);
+  int base = left->count_;
+  Transfer(left, base, parent, index);
+  for (int i = 0; i < right->count_; ++i) {
+    Transfer(left, base + 1 + i, right, i);
+  }
+  if (!left->leaf_) {
+    for (int i = 0; i <= right->count_; ++i) {
+      Adopt(left, base + 1 + i, Child(right, i));
+    }
+  }
+  left->count_ = static_cast<unsigned short>(base + 1 + right->count_);
+  for (int i = index + 1; i < parent->count_; ++i) {
+    Transfer(parent, i - 1, parent, i);
+    Adopt(parent, i, Child(parent, i + 1));
+  }
+  --parent->count_;
+  if (rightmost_ == right) {
+    rightmost_ = left;
+  }
+  FreeNode(right);
+}
+
+}  // namespace s21
@@ -0,0 +1,44 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_ITER_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_ITER_H_
+
+#include "btree_node.h"
+
+namespace s21 {
+
+// Position of an element in a BTree: a node and a slot in it. End() is
+// the slot past the last element of the rightmost leaf, or a null node
+// when the tree is empty. Like Iter, it reads elements through GetKey and
+// GetVal; any insertion or erasure invalidates it.
+template <typename Key, typename T, int N>
+class BTreeIter {
+ public:
+  using node_type = BTreeNode<Key, T, N>;
+
+  BTreeIter() noexcept;
+  BTreeIter(node_type* node, int position) noexcept;
+
+  bool operator==(const BTreeIter& other) const noexcept;
+  bool operator!=(const BTreeIter& other) const noexcept;
+  BTreeIter& operator++() noexcept;
+  BTreeIter& operator--() noexcept;
+
+  const Key& GetKey() const { return node_->Keys()[position_]; }
+
+  template <typename V = T>
+  const V& GetVal() const {
+    return node_->Vals()[position_];
+  }
+
+  node_type* GetNode() const noexcept { return node_; }
+  int GetPosition() const noexcept { return position_; }
+
+ private:
+  static node_type* Child(node_type* node, int index) noexcept;
+
+  node_type* node_;
+  int position_;
+};
+
+}  // namespace s21
+#include "btree_iter.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_ITER_H_
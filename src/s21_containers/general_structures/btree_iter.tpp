@@ -0,0 +1,93 @@
+#include "btree_iter.h"
+
+namespace s21 {
+
+template <typename Key, typename T, int N>
+BTreeIter<Key, T, N>::BTreeIter() noexcept : node_(nullptr), position_(0) {}
+
+template <typename Key, typename T, int N>
+BTreeIter<Key, T, N>::BTreeIter(node_type* node, int position) noexcept
+    : node_(node), position_(position) {}
+
+template <typename Key, typename T, int N>
+bool BTreeIter<Key, T, N>::operator==(const BTreeIter& other) const noexcept {
+  return node_ == other.node_ && position_ == other.position_;
+}
+
+template <typename Key, typename T, int N>
+bool BTreeIter<Key, T, N>::operator!=(const BTreeIter& other) const noexcept {
+  return !(*this == other);
+}
+
+template <typename Key, typename T, int N>
+BTreeIter<Key, T, N>& BTreeIter<Key, T, N>::operator++() noexcept {
+  if (node_ == nullptr) {
+    return *this;
+  }
+  if (!node_->leaf_) {
+    // The successor is the first element of the right subtree.
+    node_ = Child(node_, position_ + 1);
+    while (!node_->leaf_) {
+      node_ = Child(node_, 0);
+    }
+    position_ = 0;
+    return *this;
+  }
+  if (position_ >= node_->count_ || ++position_ < node_->count_) {
+    return *this;
+  }
+  // Past the end of a leaf: the successor is the first ancestor separator
+  // to the right. There is none after the last element, which then moves
+  // on to End() in its own leaf.
+  node_type* node = node_;
+  int position = position_;
+  while (position == node->count_ && node->parent_ != nullptr) {
+    position = node->position_;
+    node = node->parent_;
+  }
+  if (position < node->count_) {
+    node_ = node;
+    position_ = position;
+  }
+  return *this;
+}
+
+template <typename Key, typename T, int N>
+BTreeIter<Key, T, N>& BTreeIter<Key, T, N>::operator--() noexcept {
+  if (node_ == nullptr) {
+    return *this;
+  }
+  if (!node_->leaf_) {
+    // The predecessor is the last element of the left subtree.
+    node_ = Child(node_, position_);
+    while (!node_->leaf_) {
+      node_ = Child(node_, node_->count_);
+    }
+    position_ = node_->count_ - 1;
+    return *this;
+  }
+  if (position_ > 0) {
+    --position_;
+    return *this;
+  }
+  node_type* node = node_;
+  int position = position_;
+  while (position == 0 && node->parent_ != nullptr) {
+    position = node->position_;
+    node = node->parent_;
+  }
+  // Begin() has no predecessor and stays where it is.
+  if (position > 0) {
+    node_ = node;
+    position_ = position - 1;
+  }
+  return *this;
+}
+
+template <typename Key, typename T, int N>
+typename BTreeIter<Key, T, N>::node_type* BTreeIter<Key, T, N>::Child(
+    node_type* node, int index) noexcept {
+  return static_cast<BTreeInner<Key, T, N>*>(node)->children_[index];
+}
+
+}  // namespace s21
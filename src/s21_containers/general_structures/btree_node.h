@@ -0,0 +1,69 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_NODE_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_NODE_H_
+
+#include <cstddef>
+#include <type_traits>
+
+namespace s21 {
+
+// Size a B-tree node aims at: four cache lines. A lookup then reads a few
+// adjacent lines per level, and there are few levels, where the red-black
+// tree misses the cache once per level.
+inline constexpr std::size_t kBTreeNodeBytes = 256;
+
+// Values of a B-tree node, apart from the keys so that a set, which has
+// T = void, stores none.
+template <typename T, int N>
+struct BTreeValues {
+  T* Vals() noexcept { return reinterpret_cast<T*>(vals_); }
+  const T* Vals() const noexcept { return reinterpret_cast<const T*>(vals_); }
+
+  alignas(T) unsigned char vals_[N * sizeof(T)];
+};
+
+template <int N>
+struct BTreeValues<void, N> {};
+
+// Keys and values sit in raw arrays of which only the first count_ slots
+// hold objects, so neither type needs a default constructor. Leaves end
+// there; inner nodes are BTreeInner and also have count_ + 1 children.
+template <typename Key, typename T, int N>
+struct BTreeNode : BTreeValues<T, N> {
+  static constexpr int kCapacity = N;
+
+  Key* Keys() noexcept { return reinterpret_cast<Key*>(keys_); }
+  const Key* Keys() const noexcept {
+    return reinterpret_cast<const Key*>(keys_);
+  }
+
+  BTreeNode* parent_;
+  // Index of this node among the children of parent_.
+  unsigned short position_;
+  unsigned short count_;
+  bool leaf_;
+  alignas(Key) unsigned char keys_[N * sizeof(Key)];
+};
+
+template <typename Key, typename T, int N>
+struct BTreeInner : BTreeNode<Key, T, N> {
+  BTreeNode<Key, T, N>* children_[N + 1];
+};
+
+// Number of elements per node that keeps a leaf near kBTreeNodeBytes, and
+// never fewer than three, which splitting and merging need.
+template <typename Key, typename T>
+constexpr int BTreeCapacity() {
+  std::size_t slot = sizeof(Key);
+  if constexpr (!std::is_void_v<T>) {
+    slot += sizeof(T);
+  }
+  std::size_t header = 2 * sizeof(void*);
+  std::size_t count =
+      kBTreeNodeBytes > header + 3 * slot ? (kBTreeNodeBytes - header) / slot
+                                          : 3;
+  return static_cast<int>(count);
+}
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_BTREE_NODE_H_
@@ -5,14 +5,14 @@
 
 namespace s21 {
 
-template <typename Key, typename T>
-class ConstIter : public Iter<Key, T> {
+template <typename Key, typename T, typename Augment = NoAugment>
+class ConstIter : public Iter<Key, T, Augment> {
  public:
-  using typename Iter<Key, T>::value_type;
-  using typename Iter<Key, T>::key_type;
+  using typename Iter<Key, T, Augment>::value_type;
+  using typename Iter<Key, T, Augment>::key_type;
 
   ConstIter() noexcept;
-  ConstIter(const Node<Key, T>* other) noexcept;
+  ConstIter(const Node<Key, T, Augment>* other) noexcept;
   ConstIter(const ConstIter& other) noexcept;
   ConstIter(ConstIter&& other) noexcept;
   ~ConstIter() {}
@@ -21,17 +21,20 @@ class ConstIter : public Iter<Key, T> {
   ConstIter& operator=(ConstIter&& other) noexcept;
   ConstIter& operator++() noexcept;
   ConstIter& operator--() noexcept;
-  ConstIter& operator=(const Node<Key, T>* other) noexcept;
+  ConstIter& operator=(const Node<Key, T, Augment>* other) noexcept;
   bool operator!=(const ConstIter& other) const noexcept;
 
   const Key& GetKey() const { return this->current_->key_; }
 
-  const T& GetVal() const { return this->current_->val_; }
+  template <typename V = T>
+  const V& GetVal() const {
+    return this->current_->val_;
+  }
 
-  const Node<Key, T>* getCurrent() const { return this->current_; }
+  const Node<Key, T, Augment>* getCurrent() const { return this->current_; }
 
  private:
-  using Iter<Key, T>::current_;
+  using Iter<Key, T, Augment>::current_;
 };
 
 }  // namespace s21
@@ -3,25 +3,26 @@
 
 namespace s21 {
 
-template <typename Key, typename T>
-ConstIter<Key, T>::ConstIter() noexcept : Iter<Key, T>() {}
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>::ConstIter() noexcept : Iter<Key, T, Augment>() {}
 
-template <typename Key, typename T>
-ConstIter<Key, T>::ConstIter(const Node<Key, T>* other) noexcept
-    : Iter<Key, T>(const_cast<Node<Key, T>*>(other)) {}
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>::ConstIter(
+    const Node<Key, T, Augment>* other) noexcept
+    : Iter<Key, T, Augment>(const_cast<Node<Key, T, Augment>*>(other)) {}
 
-template <typename Key, typename T>
-ConstIter<Key, T>::ConstIter(const ConstIter& other) noexcept
-    : Iter<Key, T>(other) {}
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>::ConstIter(const ConstIter& other) noexcept
+    : Iter<Key, T, Augment>(other) {}
 
-template <typename Key, typename T>
-ConstIter<Key, T>::ConstIter(ConstIter&& other) noexcept
-    : Iter<Key, T>(std::move(other.current_)) {
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>::ConstIter(ConstIter&& other) noexcept
+    : Iter<Key, T, Augment>(std::move(other.current_)) {
   other.current_ = nullptr;
 }
 
-template <typename Key, typename T>
-ConstIter<Key, T>& ConstIter<Key, T>::operator=(
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>& ConstIter<Key, T, Augment>::operator=(
     const ConstIter& other) noexcept {
   if (this != &other) {
     this->current_ = other.current_;
@@ -29,8 +30,9 @@ ConstIter<Key, T>& ConstIter<Key, T>::operator=(
   return *this;
 }
 
-template <typename Key, typename T>
-ConstIter<Key, T>& ConstIter<Key, T>::operator=(ConstIter&& other) noexcept {
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>& ConstIter<Key, T, Augment>::operator=(
+    ConstIter&& other) noexcept {
   if (this != &other) {
     this->current_ = std::move(other.current_);
     other.current_ = nullptr;
@@ -38,27 +40,28 @@ ConstIter<Key, T>& ConstIter<Key, T>::operator=(ConstIter&& other) noexcept {
   return *this;
 }
 
-template <typename Key, typename T>
-ConstIter<Key, T>& ConstIter<Key, T>::operator++() noexcept {
-  Iter<Key, T>::operator++();
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>& ConstIter<Key, T, Augment>::operator++() noexcept {
+  Iter<Key, T, Augment>::operator++();
   return *this;
 }
 
-template <typename Key, typename T>
-ConstIter<Key, T>& ConstIter<Key, T>::operator--() noexcept {
-  Iter<Key, T>::operator--();
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>& ConstIter<Key, T, Augment>::operator--() noexcept {
+  Iter<Key, T, Augment>::operator--();
   return *this;
 }
 
-template <typename Key, typename T>
-ConstIter<Key, T>& ConstIter<Key, T>::operator=(
-    const Node<Key, T>* other) noexcept {
-  this->current_ = const_cast<Node<Key, T>*>(other);
+template <typename Key, typename T, typename Augment>
+ConstIter<Key, T, Augment>& ConstIter<Key, T, Augment>::operator=(
+    const Node<Key, T, Augment>* other) noexcept {
+  this->current_ = const_cast<Node<Key, T, Augment>*>(other);
   return *this;
 }
 
-template <typename Key, typename T>
-bool ConstIter<Key, T>::operator!=(const ConstIter& other) const noexcept {
+template <typename Key, typename T, typename Augment>
+bool ConstIter<Key, T, Augment>::operator!=(
+    const ConstIter& other) const noexcept {
   return this->current_ != other.current_;
 }
 
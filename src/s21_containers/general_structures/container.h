@@ -2,21 +2,41 @@
 #define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_CONTAINER_H_
 
 #include <cstddef>
+#include <functional>
+#include <future>
 #include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "const_iter.h"
 #include "iter.h"
 #include "node.h"
+#include "node_handle.h"
+#include "node_pool.h"
 
 namespace s21 {
 
-template <typename Key, typename T>
+// Red-black tree behind Set, Map, Multiset and Multimap.
+//
+// Reading never writes: const member functions, lookups and moving
+// iterators only load from nodes, and the shared leaf sentinel is fixed once
+// it is built (thread-safely, on first use). Any number of threads may read
+// one container at the same time without locking, as long as none of them
+// modifies it meanwhile; writers still need to be synchronized with
+// everything else, as for the standard containers.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Augment = NoAugment>
 class Container {
  public:
   using key_type = Key;
@@ -25,17 +45,38 @@ class Container {
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using iterator = Iter<Key, T>;
-  using const_iterator = ConstIter<Key, T>;
+  using difference_type = std::ptrdiff_t;
+  using iterator = Iter<Key, T, Augment>;
+  using const_iterator = ConstIter<Key, T, Augment>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type = NodeHandle<Key, T, Allocator, Augment>;
 
   Container() noexcept;
-  Container(std::initializer_list<value_type> const& items) noexcept;
-  Container(const Container& other) noexcept;
+  explicit Container(const Allocator& alloc) noexcept;
+  explicit Container(const Compare& comp,
+                     const Allocator& alloc = Allocator()) noexcept;
+  Container(std::initializer_list<value_type> const& items,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator()) noexcept;
+  Container(std::initializer_list<value_type> const& items,
+            const Allocator& alloc) noexcept;
+  Container(const Container& other);
+  Container(const Container& other, const Allocator& alloc);
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Container(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator());
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Container(ForwardIt first, ForwardIt last, const Allocator& alloc);
   Container(Container&& other) noexcept;
   ~Container();
 
   void operator=(Container&& other) noexcept;
-  Container<Key, T>& operator=(const Container& other) noexcept;
+  Container& operator=(const Container& other);
 
   iterator Begin() const noexcept;
   iterator End() const noexcept;
@@ -45,35 +86,317 @@ class Container {
 
   template <typename V>
   std::pair<iterator, bool> Insert(const V& value);
+  // Inserts value as close as possible to just before hint. When hint is
+  // adjacent to the insert position the node is spliced in after at most
+  // two comparisons, so appending increasing keys at End() costs amortized
+  // O(1); otherwise this is a normal insert.
+  template <typename V>
+  iterator Insert(iterator hint, const V& value);
+  // Links in the node held by node unless its key is already present, in
+  // which case node keeps it. Nothing is allocated when node came from a
+  // container whose allocator compares equal to ours.
+  std::pair<iterator, bool> Insert(node_type&& node);
+  iterator Insert(iterator hint, node_type&& node);
+
+  // Replaces the contents with [first, last). Strictly increasing input is
+  // linked into a balanced tree in O(n); anything else falls back to Insert.
+  template <typename ForwardIt>
+  void BuildFromSorted(ForwardIt first, ForwardIt last);
 
   bool Empty() const noexcept;
   size_type Size() const noexcept;
   size_type MaxSize() const noexcept;
+  void Reserve(size_type count);
+  allocator_type GetAllocator() const noexcept;
+  key_compare KeyComp() const;
 
   void Clear() noexcept;
+  // Always exchanges allocators along with the trees: nodes live in slabs
+  // owned by each container's pool, so the memory has to move with them.
+  // The comparators are exchanged too.
   void Swap(Container& other) noexcept;
 
-  void Merge(Container& other) noexcept;
+  // Both containers are assumed to order keys the same way; other's
+  // comparator is never consulted.
+  void Merge(Container& other);
+
+  // Moves every element whose key is not less than key into right, which
+  // is cleared first. The trees are cut in O(log n); the sizes of the two
+  // halves are then found by counting the smaller one.
+  void Split(const Key& key, Container& right);
+  // Appends right in O(log n) when all of its keys are greater than ours;
+  // otherwise behaves like Merge.
+  void Join(Container& right);
+
+  // Set algebra in place. The trees are cut and joined around each other's
+  // roots, so the work is O(m log(n / m + 1)) for sizes m <= n, and large
+  // independent subtrees are processed on separate threads. Colliding keys
+  // keep this container's element; Union leaves other empty.
+  void Union(Container& other);
+  void Intersection(const Container& other);
+  void Difference(const Container& other);
 
   void Erase(iterator pos);
+  // Erases [first, last). The range is cut out of the tree with two splits
+  // and the remaining halves are joined again, so this is O(log n) plus the
+  // cost of destroying the erased elements.
+  void Erase(iterator first, iterator last);
+  // Unlinks the element from the tree and hands it over in a node_type
+  // without copying or freeing anything. Both return an empty handle when
+  // there is no such element.
+  node_type Extract(iterator pos);
+  node_type Extract(const Key& key);
 
-  iterator Find(const Key& key) noexcept;
-  bool Contains(const Key& key) noexcept;
+  iterator Find(const Key& key) const;
+  bool Contains(const Key& key) const;
+  size_type Count(const Key& key) const;
+  // First element whose key is not less than key, or End().
+  iterator LowerBound(const Key& key) const;
+  // First element whose key is greater than key, or End().
+  iterator UpperBound(const Key& key) const;
+  // The elements equal to key as [LowerBound(key), UpperBound(key)), found
+  // in a single descent.
+  std::pair<iterator, iterator> EqualRange(const Key& key) const;
 
-  void DeleteTree(Node<Key, T>* node) noexcept;
-  void Rebalancing(Node<Key, T>* node) noexcept;
-  void RotateLeft(Node<Key, T>* x) noexcept;
-  void RotateRight(Node<Key, T>* x) noexcept;
-  void EraseFixup(Node<Key, T>* x) noexcept;
-  Node<Key, T>* GetRoot() const;
+  // With a transparent comparator (one that declares is_transparent, such
+  // as std::less<>), lookups accept anything comparable with Key, so no Key
+  // has to be built for them.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator Find(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool Contains(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type Count(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator LowerBound(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator UpperBound(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> EqualRange(const K& key) const;
+
+  // Order statistics; these need Augment = OrderStatistic and take
+  // O(log n). Rank is the number of elements whose key is less than key,
+  // Select(k) the element with k elements before it, and Advance moves it
+  // n positions forward or, for negative n, backward. Select and Advance
+  // return End() when the position is out of range.
+  size_type Rank(const Key& key) const;
+  iterator Select(size_type k) const;
+  iterator Advance(iterator it, difference_type n) const;
+
+  // Range queries; these need Augment = RangeAggregate<Monoid>. Aggregate
+  // folds the values of the elements with keys in [lo, hi] in key order,
+  // or returns the identity when there are none, in O(log n). Values
+  // changed in place, e.g. through operator[] or At, are only seen after
+  // Refresh(pos) has been called for them.
+  template <typename A = Augment>
+  typename A::monoid_type::value_type Aggregate(const Key& lo,
+                                                const Key& hi) const;
+  void Refresh(iterator pos) noexcept;
+
+  // Destroys the subtree below node and returns the number of elements in
+  // it. The walk is iterative, so no tree shape can exhaust the stack.
+  size_type DeleteTree(Node<Key, T, Augment>* node) noexcept;
+  // Returns true if the root had to be recolored black, which raises the
+  // black height of the whole tree by one.
+  static bool Rebalancing(Node<Key, T, Augment>* x,
+                          Node<Key, T, Augment>*& root) noexcept;
+  static void RotateLeft(Node<Key, T, Augment>* x,
+                         Node<Key, T, Augment>*& root) noexcept;
+  static void RotateRight(Node<Key, T, Augment>* x,
+                          Node<Key, T, Augment>*& root) noexcept;
+  static void EraseFixup(Node<Key, T, Augment>* x,
+                         Node<Key, T, Augment>* parent,
+                         Node<Key, T, Augment>*& root) noexcept;
+  void UpdateBounds() noexcept;
+  Node<Key, T, Augment>* GetRoot() const;
 
   void PrintTree() const;
-  void PrintTree(Node<Key, T>* node, int indent, int level) const;
+  void PrintTree(Node<Key, T, Augment>* node, int indent, int level) const;
 
  protected:
-  Node<Key, T>* root_;
-  Node<Key, T>* dummy_;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  // A detached red-black tree together with its black height. Leaves are
+  // Nil(), so an empty subtree is {Nil(), 0}.
+  struct Subtree {
+    Node<Key, T, Augment>* root_;
+    int black_height_;
+  };
+
+  // Subtrees this tall are big enough to be worth handing to a new thread.
+  static constexpr int kParallelBlackHeight = 10;
+  // Elements can move from one pool to another without a throw halfway.
+  static constexpr bool kNothrowMove =
+      std::is_nothrow_move_constructible_v<Key> &&
+      std::disjunction_v<std::is_void<T>,
+                         std::is_nothrow_move_constructible<T>>;
+
+  template <typename V>
+  static const Key& KeyOf(const V& value) noexcept;
+  template <typename V>
+  Node<Key, T, Augment>* CreateNode(const V& value);
+  // Builds a node from node_args, which are passed on to the Node
+  // constructor, and links it in unless its key is already present; then
+  // the new node is dropped again. hint may be nullptr; see Descend.
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceNode(Node<Key, T, Augment>* hint,
+                                        Args&&... node_args);
+  // Find-or-insert in a single descent: looks key up and builds a node from
+  // node_args only if it is missing, hanging it where the search ended.
+  // Nothing is constructed for a key that is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceUnique(Node<Key, T, Augment>* hint,
+                                          const Key& key, Args&&... node_args);
+  // Builds a node from node_args and links it in after every element with
+  // an equal key, so equal keys keep their insertion order; used by the
+  // multi containers. With End() as hint, a key that is not less than the
+  // last one is appended without a descent.
+  template <typename... Args>
+  iterator EmplaceEqual(Node<Key, T, Augment>* hint, Args&&... node_args);
+  // Moves node's element into the tree, see Insert(node_type&&).
+  std::pair<iterator, bool> InsertHandle(Node<Key, T, Augment>* hint,
+                                         node_type& node);
+  // Returns the node holding key, or nullptr with parent set to the node a
+  // new key would hang from and left telling on which side. Each level
+  // costs one call to the comparator; equality is checked once at the end.
+  // A non-null hint (a node or dummy_) is tried first, see Beside.
+  Node<Key, T, Augment>* Descend(const Key& key, Node<Key, T, Augment>*& parent,
+                                 bool& left,
+                                 Node<Key, T, Augment>* hint = nullptr) const;
+  // Checks whether key belongs right next to hint, i.e. just before it or
+  // just after it. If so, returns true and fills in found, or parent and
+  // left, without walking the tree.
+  bool Beside(Node<Key, T, Augment>* hint, const Key& key,
+              Node<Key, T, Augment>*& parent, bool& left,
+              Node<Key, T, Augment>*& found) const;
+  // Returns the first node whose key is not less than key, or nullptr.
+  template <typename K>
+  Node<Key, T, Augment>* LowerNode(const K& key) const;
+  // Returns the first node whose key is greater than key, or nullptr.
+  template <typename K>
+  Node<Key, T, Augment>* UpperNode(const K& key) const;
+  // Returns the node holding key, or nullptr.
+  template <typename K>
+  Node<Key, T, Augment>* FindNode(const K& key) const;
+  template <typename K>
+  std::pair<iterator, iterator> EqualNodes(const K& key) const;
+  // Links a detached node below parent, on its left side if left is set,
+  // and restores the red-black shape.
+  void AttachNode(Node<Key, T, Augment>* parent, Node<Key, T, Augment>* node,
+                  bool left) noexcept;
+  // Detaches node from the tree without touching any other node's key or
+  // value and returns it, ready to be destroyed or attached elsewhere.
+  Node<Key, T, Augment>* Unlink(Node<Key, T, Augment>* node) noexcept;
+  static void Transplant(Node<Key, T, Augment>* node,
+                         Node<Key, T, Augment>* child,
+                         Node<Key, T, Augment>*& root) noexcept;
+  // Refreshes the Augment data of node and of all its ancestors.
+  static void UpdatePath(Node<Key, T, Augment>* node) noexcept;
+  // Leaf sentinel shared by every tree of this type. It is never written
+  // after construction, so whole subtrees can move between trees in O(1).
+  static Node<Key, T, Augment>* Nil() noexcept;
+  // Makes node the largest element: dummy_ points back at it and it hangs
+  // dummy_ as its right leaf, so ++ from it reaches End().
+  void SetRightmost(Node<Key, T, Augment>* node) noexcept;
+  // Moves the tree of other into this empty container and hangs it from
+  // dummy_, since every container has its own End() node.
+  void TakeTree(Container& other) noexcept;
+
+  // Takes the whole tree out of the container, leaving it empty.
+  Subtree Detach() noexcept;
+  // Installs a detached tree holding size elements.
+  void Adopt(Subtree tree, size_type size) noexcept;
+  size_type DeleteTrees(
+      const std::vector<Node<Key, T, Augment>*>& roots) noexcept;
+  // Ends the lifetime of every node right before the pool releases its
+  // slabs as a whole; see NodePool::Discard.
+  void DiscardAll() noexcept;
+  // Calls drop on every node below node, children before their parent.
+  // Instead of a stack, the walk cuts each dropped node from its parent and
+  // climbs back up through parent_. Returns the number of nodes dropped.
+  template <typename Drop>
+  static size_type PostOrder(Node<Key, T, Augment>* node, Drop drop) noexcept;
+
+  static int BlackHeight(const Node<Key, T, Augment>* root) noexcept;
+  static Subtree JoinTrees(Subtree left, Node<Key, T, Augment>* middle,
+                           Subtree right) noexcept;
+  static Subtree JoinTrees(Subtree left, Subtree right) noexcept;
+  static Subtree RemoveMin(Subtree tree, Node<Key, T, Augment>*& min) noexcept;
+  static void SplitTree(Subtree tree, const Key& key, const Compare& comp,
+                        Subtree& left, Node<Key, T, Augment>*& match,
+                        Subtree& right);
+  static Subtree Children(Node<Key, T, Augment>* node, int black_height,
+                          Subtree& right) noexcept;
+
+  // Nodes dropped by the set operations are collected in doomed and freed
+  // by the calling thread, since the pool is not thread-safe.
+  static Subtree UnionTrees(Subtree a, Subtree b, const Compare& comp,
+                            std::vector<Node<Key, T, Augment>*>& doomed,
+                            int depth);
+  static Subtree IntersectTrees(Subtree a, const Node<Key, T, Augment>* b,
+                                const Compare& comp,
+                                std::vector<Node<Key, T, Augment>*>& doomed,
+                                int depth);
+  static Subtree SubtractTrees(Subtree a, const Node<Key, T, Augment>* b,
+                               const Compare& comp,
+                               std::vector<Node<Key, T, Augment>*>& doomed,
+                               int depth);
+  template <typename Left, typename Right>
+  static void Fork(bool parallel, std::vector<Node<Key, T, Augment>*>& doomed,
+                   Left left, Right right);
+  static int ParallelDepth() noexcept;
+  // The fewest of donor's nodes worth relinking into this tree rather than
+  // moving into pool_. Relinking keeps all of donor's slabs alive here, so
+  // it pays off only when pool_ has no free slots for the nodes and they
+  // fill at least half of those slabs. Nodes whose move may throw are
+  // always relinked.
+  size_type RelinkThreshold(
+      const NodePool<Node<Key, T, Augment>, Allocator>& donor) const noexcept;
+  // How many keys of other are missing here, counted only up to limit.
+  size_type CountMissing(const Container& other, size_type limit) const;
+  // Moves the elements of the subtree at root out of from into new nodes
+  // from to, keeping shape and colors. The slots must be reserved in to and
+  // the moves must not throw (kNothrowMove).
+  static Node<Key, T, Augment>* MoveTree(
+      Node<Key, T, Augment>* root,
+      NodePool<Node<Key, T, Augment>, Allocator>& from,
+      NodePool<Node<Key, T, Augment>, Allocator>& to) noexcept;
+  // Copies the subtree below source, shape and colors included, so no key
+  // is compared and nothing is rebalanced. Tall subtrees have their left
+  // half copied on another thread. If a copy throws, the nodes cloned so
+  // far are destroyed before the exception leaves.
+  static Node<Key, T, Augment>* CloneTree(
+      const Node<Key, T, Augment>* source, int black_height,
+      NodePool<Node<Key, T, Augment>, Allocator>& pool, int depth);
+  static void DestroyClone(
+      Node<Key, T, Augment>* root,
+      NodePool<Node<Key, T, Augment>, Allocator>& pool) noexcept;
+  template <typename Generator>
+  void BuildBalanced(size_type count, Generator& next);
+  template <typename Generator>
+  Node<Key, T, Augment>* BuildSubtree(Generator& next, size_type count,
+                             size_type depth, size_type red_depth);
+
+  Node<Key, T, Augment>* root_;
+  // Smallest node; the largest one is kept in dummy_.parent_ so that
+  // Begin() and End() are O(1) and --End() needs no tree walk. dummy_ is
+  // also the right leaf of the largest node; every other leaf is Nil().
+  Node<Key, T, Augment>* leftmost_;
+  // A sentinel without key or value, held in place so that an empty
+  // container owns no memory and T need not be default constructible. It
+  // sits in a union because it is never destroyed.
+  union {
+    Node<Key, T, Augment> dummy_;
+  };
   size_type size_cont_;
+  NodePool<Node<Key, T, Augment>, Allocator> pool_;
+  Compare comp_;
 };
 
 }  // namespace s21
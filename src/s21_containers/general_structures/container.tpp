@@ -1,171 +1,679 @@
 #include "container.h"
 namespace s21 {
 
-template <typename Key, typename T>
-Container<Key, T>::Container() noexcept : root_(nullptr), size_cont_(0) {
-  dummy_ = new Node<Key, T>;
-  dummy_->end_ = true;
-  dummy_->color_ = BLACK;
-  dummy_->left_ = nullptr;
-  dummy_->right_ = nullptr;
-  dummy_->parent_ = nullptr;
-}
-
-template <typename Key, typename T>
-Container<Key, T>::Container(
-    std::initializer_list<value_type> const& items) noexcept
-    : Container() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container() noexcept
+    : Container(Compare(), Allocator()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    const Allocator& alloc) noexcept
+    : Container(Compare(), alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    const Compare& comp, const Allocator& alloc) noexcept
+    : root_(nullptr),
+      leftmost_(nullptr),
+      dummy_(SentinelTag()),
+      size_cont_(0),
+      pool_(alloc),
+      comp_(comp) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    std::initializer_list<value_type> const& items, const Compare& comp,
+    const Allocator& alloc) noexcept
+    : Container(comp, alloc) {
   for (const auto& item : items) {
     Insert(item);
   }
 }
 
-template <typename Key, typename T>
-Container<Key, T>::Container(const Container& other) noexcept : Container() {
-  if (this != &other) {
-    for (auto it = other.Begin(); it != other.End(); ++it) {
-      if constexpr (std::is_same_v<Key, T>) {
-        Insert(it.GetKey());
-      } else {
-        value_type value(it.GetKey(), it.GetVal());
-        Insert(value);
-      }
-    }
-  }
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    std::initializer_list<value_type> const& items,
+    const Allocator& alloc) noexcept
+    : Container(items, Compare(), alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename ForwardIt, typename>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    ForwardIt first, ForwardIt last, const Compare& comp,
+    const Allocator& alloc)
+    : Container(comp, alloc) {
+  BuildFromSorted(first, last);
 }
 
-template <typename Key, typename T>
-Container<Key, T>::Container(Container&& other) noexcept {
-  if (this != &other) {
-    root_ = other.root_;
-    size_cont_ = other.size_cont_;
-    dummy_ = other.dummy_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename ForwardIt, typename>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    ForwardIt first, ForwardIt last, const Allocator& alloc)
+    : Container(first, last, Compare(), alloc) {}
 
-    other.root_ = nullptr;
-    other.size_cont_ = 0;
-    other.dummy_ = nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    const Container& other)
+    : Container(other, alloc_traits::select_on_container_copy_construction(
+                           other.GetAllocator())) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    const Container& other, const Allocator& alloc)
+    : Container(other.comp_, alloc) {
+  if (other.root_ != nullptr) {
+    root_ = CloneTree(other.root_, BlackHeight(other.root_), pool_, 0);
+    size_cont_ = other.size_cont_;
+    UpdateBounds();
   }
 }
 
-template <typename Key, typename T>
-Container<Key, T>::~Container() {
-  DeleteTree(root_);
-  if (dummy_) delete dummy_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::Container(
+    Container&& other) noexcept
+    : root_(nullptr),
+      leftmost_(nullptr),
+      dummy_(SentinelTag()),
+      size_cont_(0),
+      pool_(std::move(other.pool_)),
+      comp_(std::move(other.comp_)) {
+  TakeTree(other);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>::~Container() {
+  DiscardAll();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::DeleteTree(
+    Node<Key, T, Augment>* node) noexcept {
+  return PostOrder(node, [this](Node<Key, T, Augment>* doomed) {
+    pool_.Destroy(doomed);
+  });
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::DeleteTree(Node<Key, T>* node) noexcept {
-  if (node && node->end_ != true) {
-    Node<Key, T>* left = node->left_;
-    Node<Key, T>* right = node->right_;
-    delete node;
-    node = nullptr;
-    if (left) DeleteTree(left);
-    if (right) DeleteTree(right);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::DiscardAll() noexcept {
+  if constexpr (!NodePool<Node<Key, T, Augment>, Allocator>::DiscardIsNoop()) {
+    PostOrder(root_, [this](Node<Key, T, Augment>* doomed) {
+      pool_.Discard(doomed);
+    });
   }
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::operator=(Container&& other) noexcept {
-  if (this != &other) {
-    DeleteTree(root_);
-    if (dummy_) delete dummy_;
-    root_ = other.root_;
-    size_cont_ = other.size_cont_;
-    dummy_ = other.dummy_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename Drop>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::PostOrder(
+    Node<Key, T, Augment>* node, Drop drop) noexcept {
+  auto is_leaf = [](Node<Key, T, Augment>* child) {
+    return child == nullptr || child->end_;
+  };
+  if (is_leaf(node)) {
+    return 0;
+  }
+  size_type count = 0;
+  node->parent_ = nullptr;
+  while (node != nullptr) {
+    if (!is_leaf(node->left_)) {
+      node = node->left_;
+    } else if (!is_leaf(node->right_)) {
+      node = node->right_;
+    } else {
+      Node<Key, T, Augment>* parent = node->parent_;
+      if (parent != nullptr) {
+        (parent->left_ == node ? parent->left_ : parent->right_) = nullptr;
+      }
+      drop(node);
+      ++count;
+      node = parent;
+    }
+  }
+  return count;
+}
 
-    other.root_ = nullptr;
-    other.size_cont_ = 0;
-    other.dummy_ = nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::operator=(
+    Container&& other) noexcept {
+  if (this == &other) {
+    return;
+  }
+  if (!alloc_traits::propagate_on_container_move_assignment::value &&
+      GetAllocator() != other.GetAllocator()) {
+    // Our allocator stays and cannot free other's nodes, so the elements are
+    // moved over one by one instead of stealing the tree. They come in
+    // order, so each is appended at End(), and equal keys of the multi
+    // containers are all kept.
+    Clear();
+    comp_ = other.comp_;
+    for (auto it = other.Begin(); it != other.End(); ++it) {
+      Node<Key, T, Augment>* node = it.getCurrent();
+      EmplaceEqual(&dummy_, std::piecewise_construct,
+                   std::forward_as_tuple(std::move(node->key_)),
+                   Node<Key, T, Augment>::MoveValArgs(*node));
+    }
+    other.Clear();
+  } else {
+    DiscardAll();
+    pool_ = std::move(other.pool_);
+    comp_ = std::move(other.comp_);
+    TakeTree(other);
   }
 }
 
-template <typename Key, typename T>
-Container<Key, T>& Container<Key, T>::operator=(
-    const Container& other) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Container<Key, T, Compare, Allocator, Augment>&
+Container<Key, T, Compare, Allocator, Augment>::operator=(
+    const Container& other) {
   if (this != &other) {
-    Container<Key, T> temp(other);
-
-    std::swap(root_, temp.root_);
-    std::swap(size_cont_, temp.size_cont_);
-    std::swap(dummy_, temp.dummy_);
+    Container<Key, T, Compare, Allocator, Augment> temp(
+        other, alloc_traits::propagate_on_container_copy_assignment::value
+                   ? other.GetAllocator()
+                   : GetAllocator());
+    Swap(temp);
   }
   return *this;
 }
 
-template <typename Key, typename T>
-bool Container<Key, T>::Empty() const noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+bool Container<Key, T, Compare, Allocator, Augment>::Empty() const noexcept {
   return size_cont_ <= 0;
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::size_type Container<Key, T>::Size() const noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::Size() const noexcept {
   return size_cont_;
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::size_type Container<Key, T>::MaxSize()
-    const noexcept {
-  return SIZE_MAX / (2 * sizeof(Node<Key, T>));
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::MaxSize() const noexcept {
+  return SIZE_MAX / (2 * sizeof(Node<Key, T, Augment>));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::allocator_type
+Container<Key, T, Compare, Allocator, Augment>::GetAllocator() const noexcept {
+  return allocator_type(pool_.GetAllocator());
 }
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::key_compare
+Container<Key, T, Compare, Allocator, Augment>::KeyComp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Reserve(size_type count) {
+  if (count > size_cont_) {
+    pool_.Reserve(count - size_cont_);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
 template <typename V>
-std::pair<typename Container<Key, T>::iterator, bool> Container<Key, T>::Insert(
-    const V& val_) {
-  std::pair<iterator, bool> m;
-  m.second = false;
-  Node<Key, T>* current = root_;
-  Node<Key, T>* parent_ = nullptr;
-  Key key;
-  if constexpr (std::is_same_v<V, key_type>) {
-    key = val_;
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          bool>
+Container<Key, T, Compare, Allocator, Augment>::Insert(const V& val_) {
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  Node<Key, T, Augment>* found = Descend(KeyOf(val_), parent, left);
+  if (found != nullptr) {
+    return std::pair<iterator, bool>(iterator(found), false);
+  }
+  Node<Key, T, Augment>* node = CreateNode(val_);
+  AttachNode(parent, node, left);
+  return std::pair<iterator, bool>(iterator(node), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename V>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Insert(iterator hint,
+                                                       const V& value) {
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  Node<Key, T, Augment>* found =
+      Descend(KeyOf(value), parent, left, hint.getCurrent());
+  if (found != nullptr) {
+    return iterator(found);
+  }
+  Node<Key, T, Augment>* node = CreateNode(value);
+  AttachNode(parent, node, left);
+  return iterator(node);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          bool>
+Container<Key, T, Compare, Allocator, Augment>::Insert(node_type&& node) {
+  return InsertHandle(nullptr, node);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Insert(iterator hint,
+                                                       node_type&& node) {
+  return InsertHandle(hint.getCurrent(), node).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          bool>
+Container<Key, T, Compare, Allocator, Augment>::InsertHandle(
+    Node<Key, T, Augment>* hint, node_type& node) {
+  if (node.Empty()) {
+    return std::pair<iterator, bool>(End(), false);
+  }
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  Node<Key, T, Augment>* found = Descend(node.node_->key_, parent, left, hint);
+  if (found != nullptr) {
+    return std::pair<iterator, bool>(iterator(found), false);
+  }
+  Node<Key, T, Augment>* linked = nullptr;
+  if (node.GetAllocator() == GetAllocator()) {
+    pool_.Retain(node.group_);
+    linked = node.Release();
   } else {
-    key = val_.first;
+    linked = pool_.Create(std::piecewise_construct,
+                          std::forward_as_tuple(std::move(node.node_->key_)),
+                          Node<Key, T, Augment>::MoveValArgs(*node.node_));
+    node.Reset();
+  }
+  AttachNode(parent, linked, left);
+  return std::pair<iterator, bool>(iterator(linked), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>* Container<Key, T, Compare, Allocator, Augment>::Descend(
+    const Key& key, Node<Key, T, Augment>*& parent, bool& left,
+    Node<Key, T, Augment>* hint) const {
+  Node<Key, T, Augment>* found = nullptr;
+  if (hint != nullptr && Beside(hint, key, parent, left, found)) {
+    return found;
   }
+  // candidate is the last node whose key is not less than key; only it can
+  // be equal to key.
+  Node<Key, T, Augment>* current = root_;
+  Node<Key, T, Augment>* candidate = nullptr;
+  parent = nullptr;
+  left = false;
   while (current != nullptr && current->end_ != true) {
-    parent_ = current;
-    if (key < current->key_) {
+    parent = current;
+    left = !comp_(current->key_, key);
+    if (left) {
+      candidate = current;
       current = current->left_;
-    } else if (key > current->key_) {
-      current = current->right_;
     } else {
-      m.first = iterator(current);
-      return m;
+      current = current->right_;
     }
   }
-  Node<Key, T>* newNode = new Node<Key, T>();
-  if constexpr (std::is_same_v<V, key_type>) {
-    newNode->key_ = val_;
-    newNode->val_ = T{};
+  if (candidate != nullptr && !comp_(key, candidate->key_)) {
+    return candidate;
+  }
+  return nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+bool Container<Key, T, Compare, Allocator, Augment>::Beside(
+    Node<Key, T, Augment>* hint, const Key& key, Node<Key, T, Augment>*& parent,
+    bool& left, Node<Key, T, Augment>*& found) const {
+  if (root_ == nullptr) {
+    return false;
+  }
+  Node<Key, T, Augment>* rightmost = dummy_.parent_;
+  parent = nullptr;
+  found = nullptr;
+  if (hint->end_) {
+    // Only End() can be a hint with end_ set: key must follow rightmost.
+    if (!comp_(rightmost->key_, key)) return false;
+    parent = rightmost;
+    left = false;
+  } else if (comp_(key, hint->key_)) {
+    // The new node goes between hint's predecessor and hint. One of them
+    // has a free leaf on the facing side.
+    if (hint == leftmost_) {
+      parent = hint;
+      left = true;
+      return true;
+    }
+    iterator prev(hint);
+    --prev;
+    if (!comp_(prev.getCurrent()->key_, key)) return false;
+    left = !prev.getCurrent()->right_->end_;
+    parent = left ? hint : prev.getCurrent();
+  } else if (comp_(hint->key_, key)) {
+    if (hint == rightmost) {
+      parent = hint;
+      left = false;
+      return true;
+    }
+    iterator next(hint);
+    ++next;
+    if (!comp_(key, next.getCurrent()->key_)) return false;
+    left = !hint->right_->end_;
+    parent = left ? next.getCurrent() : hint;
   } else {
-    newNode->key_ = val_.first;
-    newNode->val_ = val_.second;
-  }
-  newNode->parent_ = parent_;
-  newNode->color_ = RED;
-  newNode->left_ = dummy_;
-  newNode->right_ = dummy_;
-
-  if (parent_ == nullptr) {
-    root_ = newNode;
-  } else if (key < parent_->key_) {
-    parent_->left_ = newNode;
+    found = hint;
+  }
+  return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::AttachNode(
+    Node<Key, T, Augment>* parent, Node<Key, T, Augment>* node,
+    bool left) noexcept {
+  node->parent_ = parent;
+  node->color_ = RED;
+  node->left_ = Nil();
+  node->right_ = Nil();
+  node->end_ = false;
+
+  if (parent == nullptr) {
+    root_ = node;
+    leftmost_ = node;
+    SetRightmost(node);
+  } else if (left) {
+    parent->left_ = node;
+    if (parent == leftmost_) leftmost_ = node;
   } else {
-    parent_->right_ = newNode;
+    parent->right_ = node;
+    if (parent == dummy_.parent_) SetRightmost(node);
   }
   size_cont_++;
-  m.first = iterator(newNode);
-  m.second = true;
-  Rebalancing(newNode);
-  return m;
+  UpdatePath(node);
+  Rebalancing(node, root_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename ForwardIt>
+void Container<Key, T, Compare, Allocator, Augment>::BuildFromSorted(
+    ForwardIt first, ForwardIt last) {
+  Clear();
+  size_type count = 0;
+  bool sorted = true;
+  for (ForwardIt prev = first, it = first; it != last; prev = it++) {
+    if (count++ > 0 && !comp_(KeyOf(*prev), KeyOf(*it))) {
+      sorted = false;
+      break;
+    }
+  }
+  if (!sorted) {
+    for (; first != last; ++first) {
+      Insert(End(), *first);
+    }
+    return;
+  }
+  auto next = [&]() {
+    Node<Key, T, Augment>* node = CreateNode(*first);
+    ++first;
+    return node;
+  };
+  BuildBalanced(count, next);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename V>
+const Key& Container<Key, T, Compare, Allocator, Augment>::KeyOf(
+    const V& value) noexcept {
+  if constexpr (std::is_same_v<V, key_type>) {
+    return value;
+  } else {
+    return value.first;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename V>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::CreateNode(const V& value) {
+  if constexpr (std::is_same_v<V, key_type>) {
+    return pool_.Create(std::piecewise_construct, std::forward_as_tuple(value),
+                        std::tuple<>());
+  } else {
+    return pool_.Create(std::piecewise_construct,
+                        std::forward_as_tuple(value.first),
+                        std::forward_as_tuple(value.second));
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename... Args>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          bool>
+Container<Key, T, Compare, Allocator, Augment>::EmplaceNode(
+    Node<Key, T, Augment>* hint, Args&&... node_args) {
+  Node<Key, T, Augment>* node = pool_.Create(std::forward<Args>(node_args)...);
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  Node<Key, T, Augment>* found = nullptr;
+  try {
+    found = Descend(node->key_, parent, left, hint);
+  } catch (...) {
+    pool_.Destroy(node);
+    throw;
+  }
+  if (found != nullptr) {
+    pool_.Destroy(node);
+    return std::pair<iterator, bool>(iterator(found), false);
+  }
+  AttachNode(parent, node, left);
+  return std::pair<iterator, bool>(iterator(node), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename... Args>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          bool>
+Container<Key, T, Compare, Allocator, Augment>::EmplaceUnique(
+    Node<Key, T, Augment>* hint, const Key& key, Args&&... node_args) {
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  Node<Key, T, Augment>* found = Descend(key, parent, left, hint);
+  if (found != nullptr) {
+    return std::pair<iterator, bool>(iterator(found), false);
+  }
+  Node<Key, T, Augment>* node = pool_.Create(std::forward<Args>(node_args)...);
+  AttachNode(parent, node, left);
+  return std::pair<iterator, bool>(iterator(node), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename... Args>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::EmplaceEqual(
+    Node<Key, T, Augment>* hint, Args&&... node_args) {
+  Node<Key, T, Augment>* node = pool_.Create(std::forward<Args>(node_args)...);
+  Node<Key, T, Augment>* rightmost = dummy_.parent_;
+  Node<Key, T, Augment>* parent = nullptr;
+  bool left = false;
+  try {
+    if (hint == &dummy_ && rightmost != nullptr &&
+        !comp_(node->key_, rightmost->key_)) {
+      parent = rightmost;
+    } else {
+      // Equal keys send the new node right, behind the ones already there.
+      Node<Key, T, Augment>* current = root_;
+      while (current != nullptr && current->end_ != true) {
+        parent = current;
+        left = comp_(node->key_, current->key_);
+        current = left ? current->left_ : current->right_;
+      }
+    }
+  } catch (...) {
+    pool_.Destroy(node);
+    throw;
+  }
+  AttachNode(parent, node, left);
+  return iterator(node);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename Generator>
+void Container<Key, T, Compare, Allocator, Augment>::BuildBalanced(
+    size_type count, Generator& next) {
+  // Levels shallower than red_depth are complete, so every path from the
+  // root to a leaf crosses exactly red_depth black nodes; the partial last
+  // level, if any, is colored red.
+  size_type red_depth = 0;
+  while ((size_type{2} << red_depth) - 1 <= count) {
+    ++red_depth;
+  }
+  root_ = BuildSubtree(next, count, 0, red_depth);
+  size_cont_ = count;
+  if (root_->end_) {
+    root_ = nullptr;
+  } else {
+    root_->parent_ = nullptr;
+  }
+  UpdateBounds();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename Generator>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::BuildSubtree(
+    Generator& next, size_type count, size_type depth, size_type red_depth) {
+  if (count == 0) {
+    return Nil();
+  }
+  size_type left_count = (count - 1) / 2;
+  Node<Key, T, Augment>* left =
+      BuildSubtree(next, left_count, depth + 1, red_depth);
+  Node<Key, T, Augment>* node = next();
+  Node<Key, T, Augment>* right =
+      BuildSubtree(next, count - 1 - left_count, depth + 1, red_depth);
+  node->left_ = left;
+  node->right_ = right;
+  if (!left->end_) left->parent_ = node;
+  if (!right->end_) right->parent_ = node;
+  node->color_ = depth == red_depth ? RED : BLACK;
+  node->end_ = false;
+  Augment::Update(node);
+  return node;
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::Rebalancing(Node<Key, T>* x) noexcept {
-  while (x != root_ && x->parent_->color_ == RED) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::CloneTree(
+    const Node<Key, T, Augment>* source, int black_height,
+    NodePool<Node<Key, T, Augment>, Allocator>& pool, int depth) {
+  if (source->end_) {
+    return Nil();
+  }
+  // The copy constructor of Node takes the color and the Augment data along.
+  Node<Key, T, Augment>* node = pool.Create(*source);
+  int child_height = black_height - (source->color_ == BLACK ? 1 : 0);
+  Node<Key, T, Augment>* left = nullptr;
+  Node<Key, T, Augment>* right = nullptr;
+  if (depth < ParallelDepth() && black_height >= kParallelBlackHeight) {
+    // The pool is not thread-safe, so the left half goes into a pool of its
+    // own, whose slabs pool keeps alive afterwards.
+    NodePool<Node<Key, T, Augment>, Allocator> left_pool(
+        Allocator(pool.GetAllocator()));
+    auto clone_left = [&] {
+      return CloneTree(source->left_, child_height, left_pool, depth + 1);
+    };
+    std::future<Node<Key, T, Augment>*> task;
+    try {
+      try {
+        task = std::async(std::launch::async, clone_left);
+      } catch (const std::system_error&) {
+        left = clone_left();
+      }
+      right = CloneTree(source->right_, child_height, pool, depth + 1);
+      if (task.valid()) left = task.get();
+      pool.Retain(left_pool);
+    } catch (...) {
+      // The task still fills left_pool, so it is joined before anything is
+      // freed. Its own exception, if any, gives way to the one in flight.
+      if (task.valid()) {
+        try {
+          left = task.get();
+        } catch (...) {
+        }
+      }
+      DestroyClone(left, left_pool);
+      DestroyClone(right, pool);
+      pool.Destroy(node);
+      throw;
+    }
+  } else {
+    try {
+      left = CloneTree(source->left_, child_height, pool, depth + 1);
+      right = CloneTree(source->right_, child_height, pool, depth + 1);
+    } catch (...) {
+      DestroyClone(left, pool);
+      pool.Destroy(node);
+      throw;
+    }
+  }
+  node->left_ = left;
+  node->right_ = right;
+  if (!left->end_) left->parent_ = node;
+  if (!right->end_) right->parent_ = node;
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::DestroyClone(
+    Node<Key, T, Augment>* root,
+    NodePool<Node<Key, T, Augment>, Allocator>& pool) noexcept {
+  PostOrder(root,
+            [&pool](Node<Key, T, Augment>* doomed) { pool.Destroy(doomed); });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+bool Container<Key, T, Compare, Allocator, Augment>::Rebalancing(
+    Node<Key, T, Augment>* x, Node<Key, T, Augment>*& root) noexcept {
+  while (x != root && x->parent_->color_ == RED) {
     if (x->parent_ == x->parent_->parent_->left_) {
-      Node<Key, T>* uncle = x->parent_->parent_->right_;
+      Node<Key, T, Augment>* uncle = x->parent_->parent_->right_;
       if (uncle->color_ == RED) {
         x->parent_->color_ = BLACK;
         uncle->color_ = BLACK;
@@ -174,14 +682,14 @@ void Container<Key, T>::Rebalancing(Node<Key, T>* x) noexcept {
       } else {
         if (x == x->parent_->right_) {
           x = x->parent_;
-          RotateLeft(x);
+          RotateLeft(x, root);
         }
         x->parent_->color_ = BLACK;
         x->parent_->parent_->color_ = RED;
-        RotateRight(x->parent_->parent_);
+        RotateRight(x->parent_->parent_, root);
       }
     } else {
-      Node<Key, T>* uncle = x->parent_->parent_->left_;
+      Node<Key, T, Augment>* uncle = x->parent_->parent_->left_;
       if (uncle->color_ == RED) {
         x->parent_->color_ = BLACK;
         uncle->color_ = BLACK;
@@ -190,27 +698,31 @@ void Container<Key, T>::Rebalancing(Node<Key, T>* x) noexcept {
       } else {
         if (x == x->parent_->left_) {
           x = x->parent_;
-          RotateRight(x);
+          RotateRight(x, root);
         }
         x->parent_->color_ = BLACK;
         x->parent_->parent_->color_ = RED;
-        RotateLeft(x->parent_->parent_);
+        RotateLeft(x->parent_->parent_, root);
       }
     }
   }
-  root_->color_ = BLACK;
+  bool grew = root->color_ == RED;
+  root->color_ = BLACK;
+  return grew;
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::RotateLeft(Node<Key, T>* x) noexcept {
-  Node<Key, T>* y = x->right_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::RotateLeft(
+    Node<Key, T, Augment>* x, Node<Key, T, Augment>*& root) noexcept {
+  Node<Key, T, Augment>* y = x->right_;
   x->right_ = y->left_;
-  if (y->left_ != dummy_) y->left_->parent_ = x;
+  if (!y->left_->end_) y->left_->parent_ = x;
 
-  if (y != dummy_) y->parent_ = x->parent_;
+  y->parent_ = x->parent_;
 
   if (x->parent_ == nullptr) {
-    root_ = y;
+    root = y;
   } else if (x == x->parent_->left_) {
     x->parent_->left_ = y;
   } else {
@@ -218,19 +730,23 @@ void Container<Key, T>::RotateLeft(Node<Key, T>* x) noexcept {
   }
 
   y->left_ = x;
-  if (x != dummy_) x->parent_ = y;
+  x->parent_ = y;
+  Augment::Update(x);
+  Augment::Update(y);
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::RotateRight(Node<Key, T>* x) noexcept {
-  Node<Key, T>* y = x->left_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::RotateRight(
+    Node<Key, T, Augment>* x, Node<Key, T, Augment>*& root) noexcept {
+  Node<Key, T, Augment>* y = x->left_;
   x->left_ = y->right_;
-  if (y->right_ != dummy_) y->right_->parent_ = x;
+  if (!y->right_->end_) y->right_->parent_ = x;
 
-  if (y != dummy_) y->parent_ = x->parent_;
+  y->parent_ = x->parent_;
 
   if (x->parent_ == nullptr) {
-    root_ = y;
+    root = y;
   } else if (x == x->parent_->right_) {
     x->parent_->right_ = y;
   } else {
@@ -238,249 +754,1258 @@ void Container<Key, T>::RotateRight(Node<Key, T>* x) noexcept {
   }
 
   y->right_ = x;
-  if (x != dummy_) x->parent_ = y;
+  x->parent_ = y;
+  Augment::Update(x);
+  Augment::Update(y);
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::iterator Container<Key, T>::Begin() const noexcept {
-  Node<Key, T>* p = nullptr;
-  if (!root_) {
-    p = dummy_;
-  } else {
-    p = root_;
-    while (p && p->left_ && p->left_->end_ != true) p = p->left_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Begin() const noexcept {
+  return root_ ? iterator(leftmost_) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::End() const noexcept {
+  // Only the links of dummy_ ever change, so it is never truly const.
+  return iterator(const_cast<Node<Key, T, Augment>*>(&dummy_));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::UpdateBounds() noexcept {
+  Node<Key, T, Augment>* first = root_;
+  Node<Key, T, Augment>* last = root_;
+  if (root_) {
+    while (!first->left_->end_) first = first->left_;
+    while (!last->right_->end_) last = last->right_;
   }
-  return iterator(p);
+  leftmost_ = first;
+  SetRightmost(last);
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::iterator Container<Key, T>::End() const noexcept {
-  Node<Key, T>* p = nullptr;
-  if (!root_) {
-    p = dummy_;
-  } else {
-    p = root_;
-    while (p && p->right_ && p->right_->end_ != true) p = p->right_;
-    Node<Key, T>* save = p;
-    p = p->right_;
-    p->parent_ = save;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::SetRightmost(
+    Node<Key, T, Augment>* node) noexcept {
+  dummy_.parent_ = node;
+  if (node != nullptr) {
+    node->right_ = &dummy_;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::TakeTree(
+    Container& other) noexcept {
+  root_ = other.root_;
+  leftmost_ = other.leftmost_;
+  size_cont_ = other.size_cont_;
+  SetRightmost(other.dummy_.parent_);
+
+  other.root_ = nullptr;
+  other.leftmost_ = nullptr;
+  other.size_cont_ = 0;
+  other.dummy_.parent_ = nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::UpdatePath(
+    Node<Key, T, Augment>* node) noexcept {
+  if constexpr (!std::is_same_v<Augment, NoAugment>) {
+    for (; node != nullptr; node = node->parent_) {
+      Augment::Update(node);
+    }
   }
-  return iterator{p};
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::Swap(Container& other) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::Nil() noexcept {
+  alignas(Node<Key, T, Augment>) static unsigned char
+      storage[sizeof(Node<Key, T, Augment>)];
+  static Node<Key, T, Augment>* const nil = ::new (
+      static_cast<void*>(storage)) Node<Key, T, Augment>(SentinelTag());
+  return nil;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Swap(
+    Container& other) noexcept {
   if (this == &other) {
     return;
   }
 
-  Node<Key, T>* tmpRoot = root_;
+  Node<Key, T, Augment>* tmpRoot = root_;
   root_ = other.root_;
   other.root_ = tmpRoot;
 
-  Node<Key, T>* tmpDummy = dummy_;
-  dummy_ = other.dummy_;
-  other.dummy_ = tmpDummy;
+  Node<Key, T, Augment>* tmpLeftmost = leftmost_;
+  leftmost_ = other.leftmost_;
+  other.leftmost_ = tmpLeftmost;
 
   size_type tmpSize = size_cont_;
   size_cont_ = other.size_cont_;
   other.size_cont_ = tmpSize;
+
+  // Each tree still ends in the other container's End() node.
+  Node<Key, T, Augment>* rightmost = other.dummy_.parent_;
+  other.SetRightmost(dummy_.parent_);
+  SetRightmost(rightmost);
+
+  pool_.Swap(other.pool_);
+  std::swap(comp_, other.comp_);
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::Merge(Container& other) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Merge(Container& other) {
   if (this == &other) {
     return;
   }
-  std::pair<Container<Key, T>::iterator, bool> res;
-  for (auto it = other.Begin(); it != other.End();) {
-    it = other.Begin();
-    for (; it != other.End(); ++it) {
-      if constexpr (std::is_same_v<Key, T>) {
-        res = Insert(it.GetKey());
+  if (GetAllocator() != other.GetAllocator()) {
+    // Other's slabs cannot be shared, so the elements are copied over and
+    // their nodes destroyed in other. Keys already present here stay there.
+    Node<Key, T, Augment>* node = other.root_ ? other.leftmost_ : nullptr;
+    while (node != nullptr && !node->end_) {
+      iterator next(node);
+      ++next;
+      Node<Key, T, Augment>* parent = nullptr;
+      bool left = false;
+      if (Descend(node->key_, parent, left) == nullptr) {
+        AttachNode(parent,
+                   pool_.Create(std::piecewise_construct,
+                                std::forward_as_tuple(node->key_),
+                                Node<Key, T, Augment>::CopyValArgs(*node)),
+                   left);
+        other.pool_.Destroy(other.Unlink(node));
+      }
+      node = next.getCurrent();
+    }
+    return;
+  }
+  // The nodes whose keys are missing here are cut out of other first, in
+  // order, and chained through right_. Once their number is known they are
+  // either relinked or have their elements moved into pool_, see
+  // RelinkThreshold, so a merge that moves nothing pins nothing.
+  Node<Key, T, Augment>* head = nullptr;
+  Node<Key, T, Augment>** tail = &head;
+  size_type moving = 0;
+  Node<Key, T, Augment>* node = other.root_ ? other.leftmost_ : nullptr;
+  while (node != nullptr && !node->end_) {
+    iterator next(node);
+    ++next;
+    if (FindNode(node->key_) == nullptr) {
+      *tail = other.Unlink(node);
+      tail = &node->right_;
+      ++moving;
+    }
+    node = next.getCurrent();
+  }
+  if (head == nullptr) {
+    return;
+  }
+  bool relink = moving >= RelinkThreshold(other.pool_);
+  Node<Key, T, Augment>* hint = nullptr;
+  try {
+    if (relink) {
+      pool_.Retain(other.pool_);
+    } else {
+      pool_.Reserve(moving);
+    }
+    while (head != nullptr) {
+      Node<Key, T, Augment>* parent = nullptr;
+      bool left = false;
+      Descend(head->key_, parent, left, hint);
+      Node<Key, T, Augment>* cut = head;
+      head = cut->right_;
+      if (relink) {
+        hint = cut;
       } else {
-        value_type value(it.GetKey(), it.GetVal());
-        res = Insert(value);
+        // Cannot throw: the slots are reserved and the moves are nothrow.
+        hint = pool_.Create(std::piecewise_construct,
+                            std::forward_as_tuple(std::move(cut->key_)),
+                            Node<Key, T, Augment>::MoveValArgs(*cut));
+        other.pool_.Destroy(cut);
       }
+      AttachNode(parent, hint, left);
+    }
+  } catch (...) {
+    // Whatever has not moved yet goes back to other.
+    while (head != nullptr) {
+      Node<Key, T, Augment>* cut = head;
+      head = cut->right_;
+      Node<Key, T, Augment>* parent = nullptr;
+      bool left = false;
+      other.Descend(cut->key_, parent, left);
+      other.AttachNode(parent, cut, left);
+    }
+    throw;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Split(const Key& key,
+                                                           Container& right) {
+  if (this == &right) {
+    return;
+  }
+  right.Clear();
+  if (GetAllocator() != right.GetAllocator()) {
+    Container temp(comp_, GetAllocator());
+    Split(key, temp);
+    right.Merge(temp);
+    return;
+  }
+  if (root_ == nullptr) {
+    return;
+  }
+  // The part from the first key not less than key on goes to right. Its
+  // size is found by walking both parts in step until one runs out.
+  Node<Key, T, Augment>* bound = LowerNode(key);
+  if (bound == nullptr) {
+    return;
+  }
+  iterator a(leftmost_);
+  iterator b(bound);
+  size_type steps = 0;
+  while (a.getCurrent() != bound && !b.getCurrent()->end_) {
+    ++a;
+    ++b;
+    ++steps;
+  }
+  size_type total = size_cont_;
+  size_type moving = b.getCurrent()->end_ ? steps : total - steps;
+  bool relink = moving >= right.RelinkThreshold(pool_);
+  if (relink) {
+    right.pool_.Retain(pool_);
+  } else {
+    right.pool_.Reserve(moving);
+  }
+  Subtree left;
+  Subtree upper;
+  Node<Key, T, Augment>* match = nullptr;
+  SplitTree(Detach(), key, comp_, left, match, upper);
+  if (match != nullptr) {
+    upper = JoinTrees(Subtree{Nil(), 0}, match, upper);
+  }
+  if (!relink) {
+    upper.root_ = MoveTree(upper.root_, pool_, right.pool_);
+  }
+  Adopt(left, total - moving);
+  right.Adopt(upper, moving);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Join(Container& right) {
+  if (this == &right || right.Empty()) {
+    return;
+  }
+  if (GetAllocator() != right.GetAllocator() ||
+      (!Empty() && !comp_(dummy_.parent_->key_, right.leftmost_->key_))) {
+    Merge(right);
+    return;
+  }
+  size_type moving = right.size_cont_;
+  bool relink = moving >= RelinkThreshold(right.pool_);
+  if (relink) {
+    pool_.Retain(right.pool_);
+  } else {
+    pool_.Reserve(moving);
+  }
+  size_type total = size_cont_ + moving;
+  Subtree left = Detach();
+  Subtree upper = right.Detach();
+  if (!relink) {
+    upper.root_ = MoveTree(upper.root_, right.pool_, pool_);
+  }
+  Node<Key, T, Augment>* middle = nullptr;
+  Subtree rest = RemoveMin(upper, middle);
+  Adopt(JoinTrees(left, middle, rest), total);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Union(Container& other) {
+  if (this == &other) {
+    return;
+  }
+  if (GetAllocator() != other.GetAllocator()) {
+    Container temp(other, GetAllocator());
+    other.Clear();
+    Union(temp);
+    return;
+  }
+  // Colliding elements of other are dropped rather than moved, so only the
+  // missing ones decide between relinking and moving.
+  size_type limit = std::max<size_type>(RelinkThreshold(other.pool_), 1);
+  if (CountMissing(other, limit) < limit) {
+    Merge(other);
+    other.Clear();
+    return;
+  }
+  pool_.Retain(other.pool_);
+  size_type total = size_cont_ + other.size_cont_;
+  std::vector<Node<Key, T, Augment>*> doomed;
+  Subtree result = UnionTrees(Detach(), other.Detach(), comp_, doomed, 0);
+  Adopt(result, total - DeleteTrees(doomed));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Intersection(
+    const Container& other) {
+  if (this == &other) {
+    return;
+  }
+  size_type total = size_cont_;
+  std::vector<Node<Key, T, Augment>*> doomed;
+  Subtree result = IntersectTrees(
+      Detach(), other.root_ ? other.root_ : Nil(), comp_, doomed, 0);
+  Adopt(result, total - DeleteTrees(doomed));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Difference(
+    const Container& other) {
+  size_type total = size_cont_;
+  if (this == &other) {
+    Clear();
+    return;
+  }
+  std::vector<Node<Key, T, Augment>*> doomed;
+  Subtree result = SubtractTrees(
+      Detach(), other.root_ ? other.root_ : Nil(), comp_, doomed, 0);
+  Adopt(result, total - DeleteTrees(doomed));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::Detach() noexcept {
+  Subtree tree{Nil(), 0};
+  if (root_ != nullptr) {
+    dummy_.parent_->right_ = Nil();
+    tree = Subtree{root_, BlackHeight(root_)};
+  }
+  root_ = nullptr;
+  leftmost_ = nullptr;
+  dummy_.parent_ = nullptr;
+  size_cont_ = 0;
+  return tree;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Adopt(
+    Subtree tree, size_type size) noexcept {
+  root_ = tree.root_->end_ ? nullptr : tree.root_;
+  if (root_ != nullptr) {
+    root_->parent_ = nullptr;
+    root_->color_ = BLACK;
+  }
+  size_cont_ = size;
+  UpdateBounds();
+}
 
-      if (res.second) {
-        other.Erase(it);
-        break;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::DeleteTrees(
+    const std::vector<Node<Key, T, Augment>*>& roots) noexcept {
+  size_type count = 0;
+  for (Node<Key, T, Augment>* root : roots) {
+    count += DeleteTree(root);
+  }
+  return count;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+int Container<Key, T, Compare, Allocator, Augment>::BlackHeight(
+    const Node<Key, T, Augment>* root) noexcept {
+  int height = 0;
+  for (; !root->end_; root = root->left_) {
+    if (root->color_ == BLACK) ++height;
+  }
+  return height;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::JoinTrees(
+    Subtree left, Node<Key, T, Augment>* middle, Subtree right) noexcept {
+  for (Subtree* tree : {&left, &right}) {
+    if (!tree->root_->end_) {
+      tree->root_->parent_ = nullptr;
+      if (tree->root_->color_ == RED) {
+        tree->root_->color_ = BLACK;
+        ++tree->black_height_;
       }
     }
   }
+  middle->end_ = false;
+  if (left.black_height_ == right.black_height_) {
+    middle->left_ = left.root_;
+    middle->right_ = right.root_;
+    if (!left.root_->end_) left.root_->parent_ = middle;
+    if (!right.root_->end_) right.root_->parent_ = middle;
+    middle->parent_ = nullptr;
+    middle->color_ = BLACK;
+    Augment::Update(middle);
+    return Subtree{middle, left.black_height_ + 1};
+  }
+  // Walk down the spine of the taller tree to the first black node whose
+  // black height matches the shorter tree and hang middle in its place.
+  bool left_taller = left.black_height_ > right.black_height_;
+  Subtree tall = left_taller ? left : right;
+  Subtree low = left_taller ? right : left;
+  Node<Key, T, Augment>* parent = nullptr;
+  Node<Key, T, Augment>* cut = tall.root_;
+  int height = tall.black_height_;
+  while (cut->color_ != BLACK || height != low.black_height_) {
+    if (cut->color_ == BLACK) --height;
+    parent = cut;
+    cut = left_taller ? cut->right_ : cut->left_;
+  }
+  middle->left_ = left_taller ? cut : low.root_;
+  middle->right_ = left_taller ? low.root_ : cut;
+  if (!cut->end_) cut->parent_ = middle;
+  if (!low.root_->end_) low.root_->parent_ = middle;
+  middle->parent_ = parent;
+  if (left_taller) {
+    parent->right_ = middle;
+  } else {
+    parent->left_ = middle;
+  }
+  middle->color_ = RED;
+  UpdatePath(middle);
+  Node<Key, T, Augment>* root = tall.root_;
+  int grew = Rebalancing(middle, root) ? 1 : 0;
+  return Subtree{root, tall.black_height_ + grew};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::JoinTrees(
+    Subtree left, Subtree right) noexcept {
+  if (right.root_->end_) return left;
+  if (left.root_->end_) return right;
+  Node<Key, T, Augment>* middle = nullptr;
+  Subtree rest = RemoveMin(right, middle);
+  return JoinTrees(left, middle, rest);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::Children(
+    Node<Key, T, Augment>* node, int black_height, Subtree& right) noexcept {
+  int child_height = black_height - (node->color_ == BLACK ? 1 : 0);
+  Subtree left{node->left_, child_height};
+  right = Subtree{node->right_, child_height};
+  if (!left.root_->end_) left.root_->parent_ = nullptr;
+  if (!right.root_->end_) right.root_->parent_ = nullptr;
+  return left;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::RemoveMin(
+    Subtree tree, Node<Key, T, Augment>*& min) noexcept {
+  Node<Key, T, Augment>* node = tree.root_;
+  Subtree right;
+  Subtree left = Children(node, tree.black_height_, right);
+  if (left.root_->end_) {
+    min = node;
+    return right;
+  }
+  return JoinTrees(RemoveMin(left, min), node, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::SplitTree(
+    Subtree tree, const Key& key, const Compare& comp, Subtree& left,
+    Node<Key, T, Augment>*& match, Subtree& right) {
+  Node<Key, T, Augment>* node = tree.root_;
+  if (node->end_) {
+    left = Subtree{Nil(), 0};
+    right = Subtree{Nil(), 0};
+    match = nullptr;
+    return;
+  }
+  Subtree node_right;
+  Subtree node_left = Children(node, tree.black_height_, node_right);
+  if (comp(key, node->key_)) {
+    Subtree rest;
+    SplitTree(node_left, key, comp, left, match, rest);
+    right = JoinTrees(rest, node, node_right);
+  } else if (comp(node->key_, key)) {
+    Subtree rest;
+    SplitTree(node_right, key, comp, rest, match, right);
+    left = JoinTrees(node_left, node, rest);
+  } else {
+    match = node;
+    left = node_left;
+    right = node_right;
+  }
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::Clear() noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::UnionTrees(
+    Subtree a, Subtree b, const Compare& comp,
+    std::vector<Node<Key, T, Augment>*>& doomed, int depth) {
+  if (a.root_->end_) return b;
+  if (b.root_->end_) return a;
+  Node<Key, T, Augment>* middle = b.root_;
+  Subtree b_right;
+  Subtree b_left = Children(middle, b.black_height_, b_right);
+  Subtree a_left;
+  Subtree a_right;
+  Node<Key, T, Augment>* match = nullptr;
+  SplitTree(a, middle->key_, comp, a_left, match, a_right);
+  if (match != nullptr) {
+    middle->left_ = Nil();
+    middle->right_ = Nil();
+    doomed.push_back(middle);
+    middle = match;
+  }
+  Subtree left;
+  Subtree right;
+  Fork(depth < ParallelDepth() && b.black_height_ >= kParallelBlackHeight,
+       doomed,
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         left = UnionTrees(a_left, b_left, comp, out, depth + 1);
+       },
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         right = UnionTrees(a_right, b_right, comp, out, depth + 1);
+       });
+  return JoinTrees(left, middle, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::IntersectTrees(
+    Subtree a, const Node<Key, T, Augment>* b, const Compare& comp,
+    std::vector<Node<Key, T, Augment>*>& doomed, int depth) {
+  if (a.root_->end_) return a;
+  if (b->end_) {
+    doomed.push_back(a.root_);
+    return Subtree{Nil(), 0};
+  }
+  Subtree a_left;
+  Subtree a_right;
+  Node<Key, T, Augment>* match = nullptr;
+  SplitTree(a, b->key_, comp, a_left, match, a_right);
+  Subtree left;
+  Subtree right;
+  Fork(depth < ParallelDepth() && a.black_height_ >= kParallelBlackHeight,
+       doomed,
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         left = IntersectTrees(a_left, b->left_, comp, out, depth + 1);
+       },
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         right = IntersectTrees(a_right, b->right_, comp, out, depth + 1);
+       });
+  return match ? JoinTrees(left, match, right) : JoinTrees(left, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::Subtree
+Container<Key, T, Compare, Allocator, Augment>::SubtractTrees(
+    Subtree a, const Node<Key, T, Augment>* b, const Compare& comp,
+    std::vector<Node<Key, T, Augment>*>& doomed, int depth) {
+  if (a.root_->end_ || b->end_) return a;
+  Subtree a_left;
+  Subtree a_right;
+  Node<Key, T, Augment>* match = nullptr;
+  SplitTree(a, b->key_, comp, a_left, match, a_right);
+  if (match != nullptr) {
+    match->left_ = Nil();
+    match->right_ = Nil();
+    doomed.push_back(match);
+  }
+  Subtree left;
+  Subtree right;
+  Fork(depth < ParallelDepth() && a.black_height_ >= kParallelBlackHeight,
+       doomed,
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         left = SubtractTrees(a_left, b->left_, comp, out, depth + 1);
+       },
+       [&](std::vector<Node<Key, T, Augment>*>& out) {
+         right = SubtractTrees(a_right, b->right_, comp, out, depth + 1);
+       });
+  return JoinTrees(left, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename Left, typename Right>
+void Container<Key, T, Compare, Allocator, Augment>::Fork(
+    bool parallel, std::vector<Node<Key, T, Augment>*>& doomed, Left left,
+    Right right) {
+  if (parallel) {
+    std::vector<Node<Key, T, Augment>*> left_doomed;
+    std::future<void> task;
+    try {
+      task = std::async(std::launch::async, [&] { left(left_doomed); });
+    } catch (const std::system_error&) {
+      left(left_doomed);
+    }
+    right(doomed);
+    if (task.valid()) task.get();
+    doomed.insert(doomed.end(), left_doomed.begin(), left_doomed.end());
+  } else {
+    left(doomed);
+    right(doomed);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::RelinkThreshold(
+    const NodePool<Node<Key, T, Augment>, Allocator>& donor) const noexcept {
+  if constexpr (!kNothrowMove) {
+    return 0;
+  } else {
+    return std::max(pool_.Available() + 1, (donor.Capacity() + 1) / 2);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::CountMissing(
+    const Container& other, size_type limit) const {
+  size_type missing = 0;
+  size_type unseen = other.size_cont_;
+  Node<Key, T, Augment>* node = other.root_ ? other.leftmost_ : nullptr;
+  // Stops as soon as limit is reached or out of reach.
+  while (missing < limit && missing + unseen >= limit) {
+    if (FindNode(node->key_) == nullptr) {
+      ++missing;
+    }
+    --unseen;
+    iterator next(node);
+    ++next;
+    node = next.getCurrent();
+  }
+  return missing;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>* Container<Key, T, Compare, Allocator, Augment>::MoveTree(
+    Node<Key, T, Augment>* root,
+    NodePool<Node<Key, T, Augment>, Allocator>& from,
+    NodePool<Node<Key, T, Augment>, Allocator>& to) noexcept {
+  if (root->end_) {
+    return root;
+  }
+  Node<Key, T, Augment>* left = MoveTree(root->left_, from, to);
+  Node<Key, T, Augment>* right = MoveTree(root->right_, from, to);
+  Node<Key, T, Augment>* node =
+      to.Create(std::piecewise_construct,
+                std::forward_as_tuple(std::move(root->key_)),
+                Node<Key, T, Augment>::MoveValArgs(*root));
+  node->color_ = root->color_;
+  node->left_ = left;
+  node->right_ = right;
+  if (!left->end_) left->parent_ = node;
+  if (!right->end_) right->parent_ = node;
+  Augment::Update(node);
+  from.Destroy(root);
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+int Container<Key, T, Compare, Allocator, Augment>::ParallelDepth() noexcept {
+  static const int depth = [] {
+    int result = 0;
+    for (unsigned threads = std::thread::hardware_concurrency(); threads > 1;
+         threads = (threads + 1) / 2) {
+      ++result;
+    }
+    return result;
+  }();
+  return depth;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Clear() noexcept {
   DeleteTree(root_);
   root_ = nullptr;
+  leftmost_ = nullptr;
   size_cont_ = 0;
-  if (dummy_) {
-    delete dummy_;
-    dummy_ = nullptr;
-  }
+  dummy_.parent_ = nullptr;
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::Erase(typename Container<Key, T>::iterator pos) {
-  Node<Key, T>* node = pos.getCurrent();
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Erase(
+    typename Container<Key, T, Compare, Allocator, Augment>::iterator pos) {
+  Node<Key, T, Augment>* node = pos.getCurrent();
   if (size_cont_ == 1) {
-    delete root_;
+    pool_.Destroy(root_);
     root_ = nullptr;
+    leftmost_ = nullptr;
+    dummy_.parent_ = nullptr;
     size_cont_ = 0;
     return;
   }
   if (node->end_) {
     return;
   }
-  if (!node->left_->end_ && !node->right_->end_) {
-    Node<Key, T>* x = node->right_;
-    while (!x->left_->end_) {
-      x = x->left_;
-    }
-    node->key_ = x->key_;
-    node->val_ = x->val_;
-    node = x;
+  pool_.Destroy(Unlink(node));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Erase(iterator first,
+                                                           iterator last) {
+  Node<Key, T, Augment>* from = first.getCurrent();
+  Node<Key, T, Augment>* to = last.getCurrent();
+  if (from == to || from->end_) {
+    return;
   }
-  if (node->left_->end_ && node->right_->end_ && node->color_ == RED) {
-    if (node->parent_->left_ == node) {
-      node->parent_->left_ = dummy_;
-    } else {
-      node->parent_->right_ = dummy_;
-    }
-    dummy_->parent_ = node->parent_;
-    delete node;
-    size_cont_--;
+  if (from == leftmost_ && to == &dummy_) {
+    Clear();
     return;
   }
-  if (node->left_->end_ || node->right_->end_) {
-    Node<Key, T>* child = node->left_->end_ ? node->right_ : node->left_;
-    bool is_black = node->color_ == BLACK;
-    child->parent_ = node->parent_;
-    if (node->parent_ == nullptr) {
-      root_ = child;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = child;
-    } else {
-      node->parent_->right_ = child;
+  // Cut the tree into [Begin(), first), [first, last) and [last, End()). The
+  // keys splitting it stay in place, as splitting never destroys a node.
+  size_type total = size_cont_;
+  Subtree lower;
+  Subtree doomed;
+  Subtree upper{Nil(), 0};
+  Node<Key, T, Augment>* match = nullptr;
+  SplitTree(Detach(), from->key_, comp_, lower, match, doomed);
+  pool_.Destroy(match);
+  size_type erased = 1;
+  if (!to->end_) {
+    Subtree rest = doomed;
+    SplitTree(rest, to->key_, comp_, doomed, match, upper);
+    upper = JoinTrees(Subtree{Nil(), 0}, match, upper);
+  }
+  erased += DeleteTree(doomed.root_);
+  Adopt(JoinTrees(lower, upper), total - erased);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::node_type
+Container<Key, T, Compare, Allocator, Augment>::Extract(iterator pos) {
+  Node<Key, T, Augment>* node = pos.getCurrent();
+  if (node == nullptr || node->end_ || size_cont_ == 0) {
+    return node_type();
+  }
+  // The handle shares the slabs the node lives in, so it stays valid even if
+  // this container goes away first. If it drops the node, the slot comes
+  // back to pool_ through the bin.
+  typename NodePool<Node<Key, T, Augment>, Allocator>::group_ptr group =
+      pool_.Share();
+  typename NodePool<Node<Key, T, Augment>, Allocator>::bin_ptr bin =
+      pool_.SharedBin();
+  return node_type(Unlink(node), std::move(group), std::move(bin),
+                   pool_.GetAllocator());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::node_type
+Container<Key, T, Compare, Allocator, Augment>::Extract(const Key& key) {
+  Node<Key, T, Augment>* node = FindNode(key);
+  if (node == nullptr) {
+    return node_type();
+  }
+  return Extract(iterator(node));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>* Container<Key, T, Compare, Allocator, Augment>::Unlink(
+    Node<Key, T, Augment>* node) noexcept {
+  Node<Key, T, Augment>* rightmost = dummy_.parent_;
+  bool is_bound = node == leftmost_ || node == rightmost;
+  NodeColors removed_color = node->color_;
+  Node<Key, T, Augment>* child = nullptr;
+  Node<Key, T, Augment>* child_parent = node->parent_;
+  if (node->left_->end_) {
+    child = node->right_;
+    Transplant(node, child, root_);
+  } else if (node->right_->end_) {
+    child = node->left_;
+    Transplant(node, child, root_);
+  } else {
+    // The successor takes node's place and color, so only the successor's
+    // old position can lose a black node.
+    Node<Key, T, Augment>* next = node->right_;
+    while (!next->left_->end_) {
+      next = next->left_;
     }
-    if (is_black) {
-      EraseFixup(child);
+    removed_color = next->color_;
+    child = next->right_;
+    if (next->parent_ == node) {
+      child_parent = next;
+    } else {
+      child_parent = next->parent_;
+      Transplant(next, child, root_);
+      next->right_ = node->right_;
+      next->right_->parent_ = next;
     }
-    delete node;
-    size_cont_--;
+    Transplant(node, next, root_);
+    next->left_ = node->left_;
+    next->left_->parent_ = next;
+    next->color_ = node->color_;
+  }
+  UpdatePath(child_parent);
+  size_cont_--;
+  if (size_cont_ == 0) {
+    root_ = nullptr;
+  } else if (removed_color == BLACK) {
+    EraseFixup(child, child_parent, root_);
+  }
+  if (is_bound) {
+    UpdateBounds();
+  } else {
+    dummy_.parent_ = rightmost;
+  }
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  node->parent_ = nullptr;
+  node->color_ = RED;
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Transplant(
+    Node<Key, T, Augment>* node, Node<Key, T, Augment>* child,
+    Node<Key, T, Augment>*& root) noexcept {
+  if (node->parent_ == nullptr) {
+    root = child;
+  } else if (node == node->parent_->left_) {
+    node->parent_->left_ = child;
+  } else {
+    node->parent_->right_ = child;
+  }
+  if (!child->end_) {
+    child->parent_ = node->parent_;
   }
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::EraseFixup(Node<Key, T>* x) noexcept {
-  while (x != root_ && x->color_ == BLACK) {
-    Node<Key, T>* parent_ = x->parent_;
-    Node<Key, T>* sibling =
-        (x == parent_->left_) ? parent_->right_ : parent_->left_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::EraseFixup(
+    Node<Key, T, Augment>* x, Node<Key, T, Augment>* parent,
+    Node<Key, T, Augment>*& root) noexcept {
+  // x may be a leaf, which is shared and never written to, so its parent is
+  // tracked separately.
+  while (x != root && x->color_ == BLACK) {
+    Node<Key, T, Augment>* sibling =
+        (x == parent->left_) ? parent->right_ : parent->left_;
     if (sibling->color_ == RED) {
       sibling->color_ = BLACK;
-      parent_->color_ = RED;
-      if (x == parent_->left_)
-        RotateLeft(parent_);
+      parent->color_ = RED;
+      if (x == parent->left_)
+        RotateLeft(parent, root);
       else
-        RotateRight(parent_);
-      sibling = (x == parent_->left_) ? parent_->right_ : parent_->left_;
+        RotateRight(parent, root);
+      sibling = (x == parent->left_) ? parent->right_ : parent->left_;
     }
 
     if (sibling->left_->color_ == BLACK && sibling->right_->color_ == BLACK) {
       sibling->color_ = RED;
-      x = parent_;
+      x = parent;
+      parent = x->parent_;
     } else {
-      if (x == parent_->left_) {
+      if (x == parent->left_) {
         if (sibling->right_->color_ == BLACK) {
           sibling->left_->color_ = BLACK;
           sibling->color_ = RED;
-          RotateRight(sibling);
-          sibling = parent_->right_;
+          RotateRight(sibling, root);
+          sibling = parent->right_;
         }
-        sibling->color_ = parent_->color_;
-        parent_->color_ = BLACK;
+        sibling->color_ = parent->color_;
+        parent->color_ = BLACK;
         sibling->right_->color_ = BLACK;
-        RotateLeft(parent_);
+        RotateLeft(parent, root);
       } else {
         if (sibling->left_->color_ == BLACK) {
           sibling->right_->color_ = BLACK;
           sibling->color_ = RED;
-          RotateLeft(sibling);
-          sibling = parent_->left_;
+          RotateLeft(sibling, root);
+          sibling = parent->left_;
         }
-        sibling->color_ = parent_->color_;
-        parent_->color_ = BLACK;
+        sibling->color_ = parent->color_;
+        parent->color_ = BLACK;
         sibling->left_->color_ = BLACK;
-        RotateRight(parent_);
+        RotateRight(parent, root);
       }
-      x = root_;
+      x = root;
     }
   }
   x->color_ = BLACK;
 }
 
-template <typename Key, typename T>
-Node<Key, T>* Container<Key, T>::GetRoot() const {
-  return root_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::Rank(const Key& key) const {
+  static_assert(std::is_same_v<Augment, OrderStatistic>,
+                "Rank needs the OrderStatistic policy");
+  size_type rank = 0;
+  Node<Key, T, Augment>* current = root_;
+  while (current != nullptr && !current->end_) {
+    if (comp_(current->key_, key)) {
+      rank += current->left_->size_ + 1;
+      current = current->right_;
+    } else {
+      current = current->left_;
+    }
+  }
+  return rank;
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::iterator Container<Key, T>::Find(
-    const Key& key) noexcept {
-  iterator it = Begin();
-  while (it != End()) {
-    if (it.GetKey() == key) {
-      return it;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Select(size_type k) const {
+  static_assert(std::is_same_v<Augment, OrderStatistic>,
+                "Select needs the OrderStatistic policy");
+  if (k >= size_cont_) {
+    return End();
+  }
+  Node<Key, T, Augment>* current = root_;
+  while (k != current->left_->size_) {
+    if (k < current->left_->size_) {
+      current = current->left_;
+    } else {
+      k -= current->left_->size_ + 1;
+      current = current->right_;
     }
-    ++it;
   }
-  return End();
+  return iterator(current);
 }
 
-template <typename Key, typename T>
-bool Container<Key, T>::Contains(const Key& key) noexcept {
-  iterator it = Find(key);
-  return (it != End());
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Advance(
+    iterator it, difference_type n) const {
+  static_assert(std::is_same_v<Augment, OrderStatistic>,
+                "Advance needs the OrderStatistic policy");
+  // The position of it is the size of its left subtree plus everything to
+  // the left of the path up to the root.
+  Node<Key, T, Augment>* node = it.getCurrent();
+  size_type index = size_cont_;
+  if (!node->end_) {
+    index = node->left_->size_;
+    for (; node->parent_ != nullptr; node = node->parent_) {
+      if (node == node->parent_->right_) {
+        index += node->parent_->left_->size_ + 1;
+      }
+    }
+  }
+  if (n < 0 && static_cast<size_type>(-n) > index) {
+    return End();
+  }
+  return Select(index + n);
 }
 
-template <typename Key, typename T>
-void Container<Key, T>::PrintTree(Node<Key, T>* node, int indent,
-                                  int level) const {
-  if (node != nullptr) {
-    std::string color_ = (node->color_ == NodeColors::RED)
-                             ? "\x1b[31mRed\x1b[0m"
-                             : "\x1b[30mBlack\x1b[0m";
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename A>
+typename A::monoid_type::value_type
+Container<Key, T, Compare, Allocator, Augment>::Aggregate(
+    const Key& lo, const Key& hi) const {
+  using Monoid = typename A::monoid_type;
+  // Below the highest node inside [lo, hi], the range is a suffix of its
+  // left subtree and a prefix of its right one. Each is collected along a
+  // single path, taking whole subtrees where they lie inside the range.
+  Node<Key, T, Augment>* top = root_;
+  while (top != nullptr && !top->end_) {
+    if (comp_(top->key_, lo)) {
+      top = top->right_;
+    } else if (comp_(hi, top->key_)) {
+      top = top->left_;
+    } else {
+      break;
+    }
+  }
+  if (top == nullptr || top->end_) {
+    return Monoid::Identity();
+  }
+  auto left = Monoid::Identity();
+  for (Node<Key, T, Augment>* node = top->left_; !node->end_;) {
+    if (comp_(node->key_, lo)) {
+      node = node->right_;
+    } else {
+      left = Monoid::Combine(
+          Monoid::Combine(FoldedValue(node), node->right_->aggregate_),
+          left);
+      node = node->left_;
+    }
+  }
+  auto right = Monoid::Identity();
+  for (Node<Key, T, Augment>* node = top->right_; !node->end_;) {
+    if (comp_(hi, node->key_)) {
+      node = node->left_;
+    } else {
+      right = Monoid::Combine(
+          right, Monoid::Combine(node->left_->aggregate_, FoldedValue(node)));
+      node = node->right_;
+    }
+  }
+  return Monoid::Combine(Monoid::Combine(left, FoldedValue(top)), right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::Refresh(
+    iterator pos) noexcept {
+  if (!pos.getCurrent()->end_) {
+    UpdatePath(pos.getCurrent());
+  }
+}
 
-    PrintTree(node->right_, indent + 4, level + 1);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::GetRoot() const {
+  return root_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Find(const Key& key) const {
+  Node<Key, T, Augment>* found = FindNode(key);
+  return found != nullptr ? iterator(found) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+bool Container<Key, T, Compare, Allocator, Augment>::Contains(
+    const Key& key) const {
+  return FindNode(key) != nullptr;
+}
 
-    if (indent > 0) {
-      std::cout << std::setw(indent) << " ";
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::Count(const Key& key) const {
+  return FindNode(key) != nullptr ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::LowerBound(
+    const Key& key) const {
+  Node<Key, T, Augment>* bound = LowerNode(key);
+  return bound != nullptr ? iterator(bound) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::UpperBound(
+    const Key& key) const {
+  Node<Key, T, Augment>* bound = UpperNode(key);
+  return bound != nullptr ? iterator(bound) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          typename Container<Key, T, Compare, Allocator, Augment>::iterator>
+Container<Key, T, Compare, Allocator, Augment>::EqualRange(
+    const Key& key) const {
+  return EqualNodes(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::Find(const K& key) const {
+  Node<Key, T, Augment>* found = FindNode(key);
+  return found != nullptr ? iterator(found) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+bool Container<Key, T, Compare, Allocator, Augment>::Contains(
+    const K& key) const {
+  return FindNode(key) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+typename Container<Key, T, Compare, Allocator, Augment>::size_type
+Container<Key, T, Compare, Allocator, Augment>::Count(const K& key) const {
+  return FindNode(key) != nullptr ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::LowerBound(const K& key) const {
+  Node<Key, T, Augment>* bound = LowerNode(key);
+  return bound != nullptr ? iterator(bound) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+typename Container<Key, T, Compare, Allocator, Augment>::iterator
+Container<Key, T, Compare, Allocator, Augment>::UpperBound(const K& key) const {
+  Node<Key, T, Augment>* bound = UpperNode(key);
+  return bound != nullptr ? iterator(bound) : End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K, typename C, typename>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          typename Container<Key, T, Compare, Allocator, Augment>::iterator>
+Container<Key, T, Compare, Allocator, Augment>::EqualRange(const K& key) const {
+  return EqualNodes(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::LowerNode(const K& key) const {
+  Node<Key, T, Augment>* current = root_;
+  Node<Key, T, Augment>* bound = nullptr;
+  while (current != nullptr && current->end_ != true) {
+    if (comp_(current->key_, key)) {
+      current = current->right_;
+    } else {
+      bound = current;
+      current = current->left_;
     }
+  }
+  return bound;
+}
 
-    std::cout << "L" << level << ":<" << node->key_ << ">,<" << node->val_
-              << "> (" << color_ << ")" << std::endl;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K>
+Node<Key, T, Augment>* Container<Key, T, Compare, Allocator, Augment>::FindNode(
+    const K& key) const {
+  Node<Key, T, Augment>* bound = LowerNode(key);
+  if (bound != nullptr && !comp_(key, bound->key_)) {
+    return bound;
+  }
+  return nullptr;
+}
 
-    PrintTree(node->left_, indent + 4, level + 1);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K>
+Node<Key, T, Augment>*
+Container<Key, T, Compare, Allocator, Augment>::UpperNode(const K& key) const {
+  Node<Key, T, Augment>* current = root_;
+  Node<Key, T, Augment>* bound = nullptr;
+  while (current != nullptr && current->end_ != true) {
+    if (comp_(key, current->key_)) {
+      bound = current;
+      current = current->left_;
+    } else {
+      current = current->right_;
+    }
   }
+  return bound;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+template <typename K>
+std::pair<typename Container<Key, T, Compare, Allocator, Augment>::iterator,
+          typename Container<Key, T, Compare, Allocator, Augment>::iterator>
+Container<Key, T, Compare, Allocator, Augment>::EqualNodes(const K& key) const {
+  // Keys are unique, so the upper bound is either the lower bound itself or
+  // the element right after it.
+  Node<Key, T, Augment>* lower = LowerNode(key);
+  if (lower == nullptr) {
+    return std::pair<iterator, iterator>(End(), End());
+  }
+  iterator upper(lower);
+  if (!comp_(key, lower->key_)) {
+    ++upper;
+  }
+  return std::pair<iterator, iterator>(iterator(lower), upper);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::PrintTree(
+    Node<Key, T, Augment>* node, int indent, int level) const {
+  // Nil() and End() hold no key or value to print.
+  if (node == nullptr || node->end_) {
+    return;
+  }
+  std::string color_ = (node->color_ == NodeColors::RED)
+                           ? "\x1b[31mRed\x1b[0m"
+                           : "\x1b[30mBlack\x1b[0m";
+
+  PrintTree(node->right_, indent + 4, level + 1);
+
+  if (indent > 0) {
+    std::cout << std::setw(indent) << " ";
+  }
+
+  std::cout << "L" << level << ":<" << node->key_ << ">,<"
+            << FoldedValue(node) << "> (" << color_ << ")" << std::endl;
+
+  PrintTree(node->left_, indent + 4, level + 1);
 }
-template <typename Key, typename T>
-void Container<Key, T>::PrintTree() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+void Container<Key, T, Compare, Allocator, Augment>::PrintTree() const {
   PrintTree(root_, 0, 0);
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::const_iterator Container<Key, T>::CBegin()
-    const noexcept {
-  return const_iterator(const_cast<Node<Key, T>*>(Begin().getCurrent()));
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::const_iterator
+Container<Key, T, Compare, Allocator, Augment>::CBegin() const noexcept {
+  return const_iterator(
+      const_cast<Node<Key, T, Augment>*>(Begin().getCurrent()));
 }
 
-template <typename Key, typename T>
-typename Container<Key, T>::const_iterator Container<Key, T>::CEnd()
-    const noexcept {
-  return const_iterator(const_cast<Node<Key, T>*>(End().getCurrent()));
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+typename Container<Key, T, Compare, Allocator, Augment>::const_iterator
+Container<Key, T, Compare, Allocator, Augment>::CEnd() const noexcept {
+  return const_iterator(const_cast<Node<Key, T, Augment>*>(End().getCurrent()));
 }
 
 }  // namespace s21
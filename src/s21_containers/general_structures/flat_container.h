@@ -0,0 +1,143 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_CONTAINER_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_CONTAINER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../vector/vector.h"
+#include "flat_iter.h"
+
+namespace s21 {
+
+// Stands in for the value array of a set.
+struct FlatNoValues {
+  FlatNoValues() noexcept = default;
+  template <typename A>
+  explicit FlatNoValues(const A&) noexcept {}
+};
+
+// Sorted keys and their values in two parallel Vectors, behind FlatMap and
+// FlatSet. Lookups are binary searches and a scan reads memory in order,
+// which suits maps that are built once and then read. A single insertion
+// or erasure shifts the arrays, so filling one element at a time costs
+// O(n^2): batches go through InsertRange, which sorts and merges in one
+// pass, and ready-made arrays through Replace.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class FlatContainer {
+ public:
+  using key_type = Key;
+  using iterator = FlatIter<Key, T>;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container = Vector<
+      Key, typename std::allocator_traits<Allocator>::template rebind_alloc<
+               Key>>;
+  using mapped_container = std::conditional_t<
+      std::is_void_v<T>, FlatNoValues,
+      Vector<T, typename std::allocator_traits<
+                    Allocator>::template rebind_alloc<T>>>;
+
+  FlatContainer() noexcept;
+  explicit FlatContainer(const Allocator& alloc) noexcept;
+  explicit FlatContainer(const Compare& comp,
+                         const Allocator& alloc = Allocator()) noexcept;
+  FlatContainer(const FlatContainer& other) = default;
+  FlatContainer(FlatContainer&& other) = default;
+  ~FlatContainer() = default;
+
+  FlatContainer& operator=(const FlatContainer& other);
+  FlatContainer& operator=(FlatContainer&& other) = default;
+
+  iterator Begin() const noexcept;
+  iterator End() const noexcept;
+  const_iterator CBegin() const noexcept;
+  const_iterator CEnd() const noexcept;
+
+  bool Empty() const noexcept;
+  size_type Size() const noexcept;
+  size_type MaxSize() const noexcept;
+  void Reserve(size_type count);
+  allocator_type GetAllocator() const;
+  key_compare KeyComp() const;
+
+  void Clear() noexcept;
+  void Swap(FlatContainer& other);
+  // Moves over the elements of other whose keys are missing here; the
+  // others stay in other. Both arrays are rebuilt in one merge pass.
+  void Merge(FlatContainer& other);
+
+  void Erase(iterator pos);
+  void Erase(iterator first, iterator last);
+
+  iterator Find(const Key& key) const;
+  bool Contains(const Key& key) const;
+  size_type Count(const Key& key) const;
+  // First element whose key is not less than key, or End().
+  iterator LowerBound(const Key& key) const;
+  // First element whose key is greater than key, or End().
+  iterator UpperBound(const Key& key) const;
+  std::pair<iterator, iterator> EqualRange(const Key& key) const;
+
+ protected:
+  // Inserts key with a value built from val_args unless key is present, in
+  // which case val_args are left untouched. A set passes no val_args.
+  template <typename K, typename... ValArgs>
+  std::pair<iterator, bool> EmplaceUnique(K&& key, ValArgs&&... val_args);
+  // Inserts [first, last), keys or pairs of key and value, keeping the
+  // element already present, or the first in the range, for equal keys.
+  // The range is sorted on its own and then merged with the arrays.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last);
+  // Takes over keys and vals as the contents. Strictly increasing keys are
+  // adopted as they are after an O(n) check; otherwise the pairs are
+  // sorted first and only the first of equal keys is kept.
+  void Replace(key_container&& keys, mapped_container&& vals);
+
+  template <typename V = T>
+  static V& ValueAt(iterator pos) noexcept {
+    return *pos.GetValPointer();
+  }
+
+ private:
+  using staged_type =
+      std::conditional_t<std::is_void_v<T>, Key, std::pair<Key, T>>;
+  // Scratch array for sorting, drawing memory from the container's
+  // allocator like the arrays themselves.
+  template <typename U>
+  using buffer = std::vector<
+      U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+
+  static const Key& StagedKey(const staged_type& staged) noexcept;
+
+  size_type LowerIndex(const Key& key) const;
+  size_type IndexOf(iterator pos) const noexcept;
+  iterator IteratorAt(size_type index) const noexcept;
+  // Doubles the capacity of both arrays when they are full.
+  void Grow();
+  // Appends the element of keys and vals at index to the new arrays.
+  static void MoveOver(key_container& keys, mapped_container& vals,
+                       size_type index, key_container& to_keys,
+                       mapped_container& to_vals);
+
+  key_container keys_;
+  mapped_container vals_;
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#include "flat_container.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_CONTAINER_H_
@@ -0,0 +1,394 @@
+#include "flat_container.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+FlatContainer<Key, T, Compare, Allocator>::FlatContainer() noexcept
+    : FlatContainer(Compare(), Allocator()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+FlatContainer<Key, T, Compare, Allocator>::FlatContainer(
+    const Allocator& alloc) noexcept
+    : FlatContainer(Compare(), alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+FlatContainer<Key, T, Compare, Allocator>::FlatContainer(
+    const Compare& comp, const Allocator& alloc) noexcept
+    : keys_(alloc), vals_(alloc), comp_(comp) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+FlatContainer<Key, T, Compare, Allocator>&
+FlatContainer<Key, T, Compare, Allocator>::operator=(
+    const FlatContainer& other) {
+  if (this != &other) {
+    FlatContainer<Key, T, Compare, Allocator> temp(other);
+    Swap(temp);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::Begin() const noexcept {
+  return IteratorAt(0);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::End() const noexcept {
+  return IteratorAt(keys_.Size());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::const_iterator
+FlatContainer<Key, T, Compare, Allocator>::CBegin() const noexcept {
+  return Begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::const_iterator
+FlatContainer<Key, T, Compare, Allocator>::CEnd() const noexcept {
+  return End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool FlatContainer<Key, T, Compare, Allocator>::Empty() const noexcept {
+  return keys_.Empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::size_type
+FlatContainer<Key, T, Compare, Allocator>::Size() const noexcept {
+  return keys_.Size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::size_type
+FlatContainer<Key, T, Compare, Allocator>::MaxSize() const noexcept {
+  if constexpr (std::is_void_v<T>) {
+    return keys_.MaxSize();
+  } else {
+    return std::min(keys_.MaxSize(), vals_.MaxSize());
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Reserve(size_type count) {
+  keys_.Reserve(count);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Reserve(count);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::allocator_type
+FlatContainer<Key, T, Compare, Allocator>::GetAllocator() const {
+  return Allocator(keys_.GetAllocator());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::key_compare
+FlatContainer<Key, T, Compare, Allocator>::KeyComp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Clear() noexcept {
+  keys_.Clear();
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Clear();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Swap(FlatContainer& other) {
+  keys_.Swap(other.keys_);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Swap(other.vals_);
+  }
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Merge(FlatContainer& other) {
+  if (this == &other) {
+    return;
+  }
+  key_container keys(keys_.GetAllocator());
+  mapped_container vals(keys_.GetAllocator());
+  key_container kept_keys(other.keys_.GetAllocator());
+  mapped_container kept_vals(other.keys_.GetAllocator());
+  size_type n = keys_.Size();
+  size_type m = other.keys_.Size();
+  // At most min(n, m) keys collide and stay in other.
+  keys.Reserve(n + m);
+  kept_keys.Reserve(std::min(n, m));
+  if constexpr (!std::is_void_v<T>) {
+    vals.Reserve(n + m);
+    kept_vals.Reserve(std::min(n, m));
+  }
+  size_type i = 0;
+  size_type j = 0;
+  while (i < n || j < m) {
+    if (j == m || (i < n && comp_(keys_[i], other.keys_[j]))) {
+      MoveOver(keys_, vals_, i++, keys, vals);
+    } else if (i == n || comp_(other.keys_[j], keys_[i])) {
+      MoveOver(other.keys_, other.vals_, j++, keys, vals);
+    } else {
+      MoveOver(keys_, vals_, i++, keys, vals);
+      MoveOver(other.keys_, other.vals_, j++, kept_keys, kept_vals);
+    }
+  }
+  keys_.Swap(keys);
+  other.keys_.Swap(kept_keys);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Swap(vals);
+    other.vals_.Swap(kept_vals);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Erase(iterator pos) {
+  size_type index = IndexOf(pos);
+  keys_.Erase(keys_.Begin() + index);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Erase(vals_.Begin() + index);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Erase(iterator first,
+                                                      iterator last) {
+  size_type from = IndexOf(first);
+  size_type to = IndexOf(last);
+  keys_.Erase(keys_.Begin() + from, keys_.Begin() + to);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Erase(vals_.Begin() + from, vals_.Begin() + to);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::Find(const Key& key) const {
+  size_type index = LowerIndex(key);
+  if (index < keys_.Size() && !comp_(key, keys_.Data()[index])) {
+    return IteratorAt(index);
+  }
+  return End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool FlatContainer<Key, T, Compare, Allocator>::Contains(
+    const Key& key) const {
+  return Find(key) != End();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::size_type
+FlatContainer<Key, T, Compare, Allocator>::Count(const Key& key) const {
+  return Contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::LowerBound(const Key& key) const {
+  return IteratorAt(LowerIndex(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::UpperBound(const Key& key) const {
+  const Key* keys = keys_.Data();
+  return IteratorAt(static_cast<size_type>(
+      std::upper_bound(keys, keys + keys_.Size(), key, comp_) - keys));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename FlatContainer<Key, T, Compare, Allocator>::iterator,
+          typename FlatContainer<Key, T, Compare, Allocator>::iterator>
+FlatContainer<Key, T, Compare, Allocator>::EqualRange(const Key& key) const {
+  iterator first = LowerBound(key);
+  iterator last = first;
+  if (first != End() && !comp_(key, first.GetKey())) {
+    ++last;
+  }
+  return {first, last};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename... ValArgs>
+std::pair<typename FlatContainer<Key, T, Compare, Allocator>::iterator, bool>
+FlatContainer<Key, T, Compare, Allocator>::EmplaceUnique(
+    K&& key, ValArgs&&... val_args) {
+  size_type index = LowerIndex(key);
+  if (index < keys_.Size() && !comp_(key, keys_[index])) {
+    return {IteratorAt(index), false};
+  }
+  Grow();
+  if constexpr (std::is_void_v<T>) {
+    keys_.Insert(keys_.Begin() + index, Key(std::forward<K>(key)));
+  } else {
+    T val(std::forward<ValArgs>(val_args)...);
+    keys_.Insert(keys_.Begin() + index, Key(std::forward<K>(key)));
+    try {
+      vals_.Insert(vals_.Begin() + index, std::move(val));
+    } catch (...) {
+      keys_.Erase(keys_.Begin() + index);
+      throw;
+    }
+  }
+  return {IteratorAt(index), true};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+void FlatContainer<Key, T, Compare, Allocator>::InsertRange(InputIt first,
+                                                            InputIt last) {
+  using staged_allocator = typename buffer<staged_type>::allocator_type;
+  buffer<staged_type> staged(first, last,
+                             staged_allocator(keys_.GetAllocator()));
+  auto less = [this](const staged_type& a, const staged_type& b) {
+    return comp_(StagedKey(a), StagedKey(b));
+  };
+  std::stable_sort(staged.begin(), staged.end(), less);
+  staged.erase(std::unique(staged.begin(), staged.end(),
+                           [&less](const staged_type& a,
+                                   const staged_type& b) {
+                             return !less(a, b);
+                           }),
+               staged.end());
+
+  key_container keys(keys_.GetAllocator());
+  mapped_container vals(keys_.GetAllocator());
+  size_type n = keys_.Size();
+  keys.Reserve(n + staged.size());
+  if constexpr (!std::is_void_v<T>) {
+    vals.Reserve(n + staged.size());
+  }
+  size_type i = 0;
+  auto next = staged.begin();
+  while (i < n || next != staged.end()) {
+    if (next == staged.end() ||
+        (i < n && !comp_(StagedKey(*next), keys_[i]))) {
+      if (next != staged.end() && !comp_(keys_[i], StagedKey(*next))) {
+        ++next;
+      }
+      MoveOver(keys_, vals_, i++, keys, vals);
+    } else if constexpr (std::is_void_v<T>) {
+      keys.PushBack(std::move(*next++));
+    } else {
+      keys.PushBack(std::move(next->first));
+      vals.PushBack(std::move(next->second));
+      ++next;
+    }
+  }
+  keys_.Swap(keys);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Swap(vals);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Replace(
+    key_container&& keys, mapped_container&& vals) {
+  size_type n = keys.Size();
+  if constexpr (!std::is_void_v<T>) {
+    if (vals.Size() != n) {
+      throw std::invalid_argument("Keys and values differ in number");
+    }
+  }
+  bool sorted = true;
+  for (size_type i = 1; i < n && sorted; ++i) {
+    sorted = comp_(keys[i - 1], keys[i]);
+  }
+  if (sorted) {
+    keys_ = std::move(keys);
+    if constexpr (!std::is_void_v<T>) {
+      vals_ = std::move(vals);
+    }
+    return;
+  }
+  using order_allocator = typename buffer<size_type>::allocator_type;
+  buffer<size_type> order(n, order_allocator(keys_.GetAllocator()));
+  std::iota(order.begin(), order.end(), size_type(0));
+  std::stable_sort(order.begin(), order.end(),
+                   [this, &keys](size_type a, size_type b) {
+                     return comp_(keys[a], keys[b]);
+                   });
+  key_container sorted_keys(keys_.GetAllocator());
+  mapped_container sorted_vals(keys_.GetAllocator());
+  sorted_keys.Reserve(n);
+  if constexpr (!std::is_void_v<T>) {
+    sorted_vals.Reserve(n);
+  }
+  for (size_type i = 0; i < n; ++i) {
+    if (i == 0 || comp_(keys[order[i - 1]], keys[order[i]])) {
+      MoveOver(keys, vals, order[i], sorted_keys, sorted_vals);
+    }
+  }
+  keys_.Swap(sorted_keys);
+  if constexpr (!std::is_void_v<T>) {
+    vals_.Swap(sorted_vals);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const Key& FlatContainer<Key, T, Compare, Allocator>::StagedKey(
+    const staged_type& staged) noexcept {
+  if constexpr (std::is_void_v<T>) {
+    return staged;
+  } else {
+    return staged.first;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::size_type
+FlatContainer<Key, T, Compare, Allocator>::LowerIndex(const Key& key) const {
+  const Key* keys = keys_.Data();
+  return static_cast<size_type>(
+      std::lower_bound(keys, keys + keys_.Size(), key, comp_) - keys);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::size_type
+FlatContainer<Key, T, Compare, Allocator>::IndexOf(
+    iterator pos) const noexcept {
+  return static_cast<size_type>(pos.GetKeyPointer() - keys_.Data());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename FlatContainer<Key, T, Compare, Allocator>::iterator
+FlatContainer<Key, T, Compare, Allocator>::IteratorAt(
+    size_type index) const noexcept {
+  if constexpr (std::is_void_v<T>) {
+    return iterator(keys_.Data() + index, nullptr);
+  } else {
+    // Lookups are const, but the iterator they return gives FlatMap
+    // mutable access to the value, as Iter does through its node.
+    return iterator(keys_.Data() + index,
+                    const_cast<T*>(vals_.Data()) + index);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::Grow() {
+  if (keys_.Size() == keys_.Capacity()) {
+    Reserve(std::max<size_type>(2 * keys_.Size(), 8));
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void FlatContainer<Key, T, Compare, Allocator>::MoveOver(
+    key_container& keys, mapped_container& vals, size_type index,
+    key_container& to_keys, mapped_container& to_vals) {
+  to_keys.PushBack(std::move(keys[index]));
+  if constexpr (!std::is_void_v<T>) {
+    to_vals.PushBack(std::move(vals[index]));
+  } else {
+    static_cast<void>(vals);
+    static_cast<void>(to_vals);
+  }
+}
+
+}  // namespace s21
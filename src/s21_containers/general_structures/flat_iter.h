@@ -0,0 +1,56 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_ITER_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_ITER_H_
+
+#include <type_traits>
+
+namespace s21 {
+
+// Position in the parallel key and value arrays of a FlatContainer. A set
+// has T = void and only walks the keys. Like Iter, it reads elements
+// through GetKey and GetVal; any insertion or erasure invalidates it.
+template <typename Key, typename T>
+class FlatIter {
+ public:
+  FlatIter() noexcept : key_(nullptr), val_(nullptr) {}
+  FlatIter(const Key* key, T* val) noexcept : key_(key), val_(val) {}
+
+  bool operator==(const FlatIter& other) const noexcept {
+    return key_ == other.key_;
+  }
+  bool operator!=(const FlatIter& other) const noexcept {
+    return key_ != other.key_;
+  }
+
+  FlatIter& operator++() noexcept {
+    ++key_;
+    if constexpr (!std::is_void_v<T>) {
+      ++val_;
+    }
+    return *this;
+  }
+
+  FlatIter& operator--() noexcept {
+    --key_;
+    if constexpr (!std::is_void_v<T>) {
+      --val_;
+    }
+    return *this;
+  }
+
+  const Key& GetKey() const { return *key_; }
+
+  template <typename V = T>
+  const V& GetVal() const {
+    return *val_;
+  }
+
+  const Key* GetKeyPointer() const noexcept { return key_; }
+  T* GetValPointer() const noexcept { return val_; }
+
+ private:
+  const Key* key_;
+  T* val_;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_FLAT_ITER_H_
@@ -0,0 +1,72 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_GROUP_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_GROUP_H_
+
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+// Control bytes of a HashTable, one per slot. A full slot holds the low
+// seven bits of its hash, so its byte is never negative; the free states
+// all have the sign bit set.
+inline constexpr signed char kHashEmpty = -128;
+inline constexpr signed char kHashDeleted = -2;
+// Follows the last slot so that iterators stop there.
+inline constexpr signed char kHashSentinel = -1;
+
+// Index of the lowest set bit of a non-zero mask.
+inline int LowestBit(unsigned mask) noexcept { return __builtin_ctz(mask); }
+
+// Sixteen control bytes matched at once: bit i of each mask is set when
+// byte i qualifies. With SSE2, which every x86-64 target has, a match is
+// one compare and one movemask; other targets loop over the bytes.
+class HashGroup {
+ public:
+  static constexpr std::size_t kWidth = 16;
+
+#ifdef __SSE2__
+  explicit HashGroup(const signed char* ctrl) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  unsigned Match(signed char h2) const noexcept {
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+  unsigned MatchEmpty() const noexcept { return Match(kHashEmpty); }
+  // Empty or deleted slots, the only bytes with the sign bit set.
+  unsigned MatchFree() const noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(ctrl_));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit HashGroup(const signed char* ctrl) noexcept : ctrl_(ctrl) {}
+
+  unsigned Match(signed char h2) const noexcept {
+    unsigned mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<unsigned>(ctrl_[i] == h2) << i;
+    }
+    return mask;
+  }
+  unsigned MatchEmpty() const noexcept { return Match(kHashEmpty); }
+  unsigned MatchFree() const noexcept {
+    unsigned mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<unsigned>(ctrl_[i] < 0) << i;
+    }
+    return mask;
+  }
+
+ private:
+  const signed char* ctrl_;
+#endif
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_GROUP_H_
@@ -0,0 +1,67 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_ITER_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_ITER_H_
+
+#include <type_traits>
+
+#include "hash_group.h"
+
+namespace s21 {
+
+// Slot of a HashTable: its control byte, key and value. Only forward
+// steps are supported, skipping free slots up to the sentinel after the
+// last one. Like Iter, it reads elements through GetKey and GetVal. Erasure
+// invalidates only iterators to the erased element; an insertion that
+// grows or rehashes the table invalidates all of them.
+template <typename Key, typename T>
+class HashIter {
+ public:
+  HashIter() noexcept : ctrl_(nullptr), key_(nullptr), val_(nullptr) {}
+  HashIter(const signed char* ctrl, const Key* key, T* val) noexcept
+      : ctrl_(ctrl), key_(key), val_(val) {}
+
+  bool operator==(const HashIter& other) const noexcept {
+    return ctrl_ == other.ctrl_;
+  }
+  bool operator!=(const HashIter& other) const noexcept {
+    return ctrl_ != other.ctrl_;
+  }
+
+  HashIter& operator++() noexcept {
+    Step();
+    SkipFree();
+    return *this;
+  }
+
+  // Moves on to the first full slot or the sentinel.
+  void SkipFree() noexcept {
+    while (*ctrl_ < 0 && *ctrl_ != kHashSentinel) {
+      Step();
+    }
+  }
+
+  const Key& GetKey() const { return *key_; }
+
+  template <typename V = T>
+  const V& GetVal() const {
+    return *val_;
+  }
+
+  const signed char* GetCtrl() const noexcept { return ctrl_; }
+  T* GetValPointer() const noexcept { return val_; }
+
+ private:
+  void Step() noexcept {
+    ++ctrl_;
+    ++key_;
+    if constexpr (!std::is_void_v<T>) {
+      ++val_;
+    }
+  }
+
+  const signed char* ctrl_;
+  const Key* key_;
+  T* val_;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_ITER_H_
@@ -0,0 +1,180 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_TABLE_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hash_group.h"
+#include "hash_iter.h"
+#include "node.h"
+
+namespace s21 {
+
+// Open-addressing hash table behind UnorderedMap and UnorderedSet, laid
+// out as a Swiss table. Keys, values and one control byte per slot sit in
+// three flat arrays whose size, the capacity, is a power of two and at
+// least one HashGroup. A hash picks a group to start probing at with its
+// high bits; its low seven bits go into the control byte, so a lookup
+// matches a whole group of bytes at once and compares only the few keys
+// whose bytes agree. Probing moves group by group until one has an empty
+// slot.
+//
+// The table holds at most 7/8 of its capacity, counting deleted slots as
+// used. An erased slot becomes empty again when its group still has an
+// empty slot, since no probe can then have passed through the group;
+// otherwise it is marked deleted until the next rehash. A set has
+// T = void and stores keys only.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class HashTable {
+ public:
+  using key_type = Key;
+  using iterator = HashIter<Key, T>;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  HashTable() noexcept;
+  explicit HashTable(const Allocator& alloc) noexcept;
+  explicit HashTable(const Hash& hash, const KeyEqual& equal = KeyEqual(),
+                     const Allocator& alloc = Allocator()) noexcept;
+  HashTable(const HashTable& other);
+  HashTable(const HashTable& other, const Allocator& alloc);
+  HashTable(HashTable&& other) noexcept;
+  ~HashTable();
+
+  HashTable& operator=(const HashTable& other);
+  HashTable& operator=(HashTable&& other) noexcept;
+
+  iterator Begin() const noexcept;
+  iterator End() const noexcept;
+  const_iterator CBegin() const noexcept;
+  const_iterator CEnd() const noexcept;
+
+  bool Empty() const noexcept;
+  size_type Size() const noexcept;
+  size_type MaxSize() const noexcept;
+  allocator_type GetAllocator() const noexcept;
+  hasher HashFunction() const;
+  key_equal KeyEq() const;
+
+  // Number of slots.
+  size_type BucketCount() const noexcept;
+  float LoadFactor() const noexcept;
+  // Makes room for count elements without a rehash.
+  void Reserve(size_type count);
+  // Rebuilds the table with at least count slots, and enough for Size(),
+  // dropping deleted slots. Rehash(0) on an empty table frees its memory.
+  void Rehash(size_type count);
+
+  // Destroys the elements but keeps the slots.
+  void Clear() noexcept;
+  void Swap(HashTable& other) noexcept;
+  // Moves over the elements of other whose keys are missing here; the
+  // others stay in other.
+  void Merge(HashTable& other);
+
+  void Erase(iterator pos);
+  void Erase(iterator first, iterator last);
+
+  iterator Find(const Key& key) const;
+  bool Contains(const Key& key) const;
+  size_type Count(const Key& key) const;
+  std::pair<iterator, iterator> EqualRange(const Key& key) const;
+
+ protected:
+  // Builds an element from the two tuples unless key is already present,
+  // in which case the tuples are left untouched. val_args is ignored by a
+  // set.
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> EmplaceUnique(const Key& key,
+                                          std::tuple<KeyArgs...> key_args,
+                                          std::tuple<ValArgs...> val_args);
+  template <typename V = T>
+  static V& ValueAt(iterator pos) noexcept {
+    return *pos.GetValPointer();
+  }
+
+ private:
+  static constexpr size_type kWidth = HashGroup::kWidth;
+
+  // Type of the value array; a set allocates none.
+  using stored_type = std::conditional_t<std::is_void_v<T>, char, T>;
+  using ctrl_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<signed char>;
+  using key_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+  using val_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<stored_type>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+  using key_traits = std::allocator_traits<key_allocator>;
+  using val_traits = std::allocator_traits<val_allocator>;
+
+  // Spreads the bits of the user hash, which for integers is often the
+  // value itself, over the whole word.
+  size_type HashOf(const Key& key) const;
+  static size_type H1(size_type hash) noexcept { return hash >> 7; }
+  static signed char H2(size_type hash) noexcept {
+    return static_cast<signed char>(hash & 0x7F);
+  }
+  static size_type MaxLoad(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+  // Smallest capacity that holds count elements.
+  static size_type CapacityFor(size_type count) noexcept;
+
+  // Slot holding key, or capacity_ when there is none.
+  size_type FindIndex(const Key& key, size_type hash) const;
+  // First empty or deleted slot on the probe sequence of hash.
+  size_type FindFree(size_type hash) const noexcept;
+  iterator IteratorAt(size_type index) const noexcept;
+  size_type IndexOf(iterator pos) const noexcept;
+
+  // Points the table at fresh arrays of capacity slots, all empty. The old
+  // arrays are left to the caller.
+  void Allocate(size_type capacity);
+  void Deallocate(signed char* ctrl, Key* keys, stored_type* vals,
+                  size_type capacity) noexcept;
+  // Frees the arrays of an empty table.
+  void Release() noexcept;
+  void DestroyAll() noexcept;
+  void Destroy(size_type index) noexcept;
+  // Moves every element into capacity fresh slots.
+  void Resize(size_type capacity);
+  // Called when an insertion finds no room: doubles the capacity, or
+  // rehashes in place when deleted slots took most of the room.
+  void Grow();
+  // Moves the element at source, in another table, into target unless its
+  // key is already there, and tells whether it did.
+  static bool MoveInto(HashTable& target, iterator source);
+
+  signed char* ctrl_;
+  Key* keys_;
+  stored_type* vals_;
+  size_type capacity_;
+  size_type size_;
+  // Empty slots that may still be filled before the table must grow.
+  size_type growth_left_;
+  ctrl_allocator ctrl_alloc_;
+  key_allocator key_alloc_;
+  val_allocator val_alloc_;
+  Hash hash_;
+  KeyEqual equal_;
+};
+
+}  // namespace s21
+
+#include "hash_table.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_HASH_TABLE_H_
@@ -0,0 +1,637 @@
+#include "hash_table.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable() noexcept
+    : HashTable(Hash(), KeyEqual(), Allocator()) {}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable(
+    const Allocator& alloc) noexcept
+    : HashTable(Hash(), KeyEqual(), alloc) {}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable(
+    const Hash& hash, const KeyEqual& equal, const Allocator& alloc) noexcept
+    : ctrl_(nullptr),
+      keys_(nullptr),
+      vals_(nullptr),
+      capacity_(0),
+      size_(0),
+      growth_left_(0),
+      ctrl_alloc_(alloc),
+      key_alloc_(alloc),
+      val_alloc_(alloc),
+      hash_(hash),
+      equal_(equal) {}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable(const HashTable& other)
+    : HashTable(other, std::allocator_traits<Allocator>::
+                           select_on_container_copy_construction(
+                               other.GetAllocator())) {}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable(
+    const HashTable& other, const Allocator& alloc)
+    : HashTable(other.hash_, other.equal_, alloc) {
+  if (other.capacity_ == 0) {
+    return;
+  }
+  // Slot for slot, deleted ones included, so nothing is hashed again. A
+  // control byte is copied only once its slot holds an object, so Clear
+  // can undo a partial copy.
+  Allocate(other.capacity_);
+  try {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (other.ctrl_[i] >= 0) {
+        ::new (static_cast<void*>(keys_ + i)) Key(other.keys_[i]);
+        if constexpr (!std::is_void_v<T>) {
+          try {
+            ::new (static_cast<void*>(vals_ + i)) T(other.vals_[i]);
+          } catch (...) {
+            keys_[i].~Key();
+            throw;
+          }
+        }
+        ++size_;
+      }
+      ctrl_[i] = other.ctrl_[i];
+    }
+  } catch (...) {
+    Clear();
+    Release();
+    throw;
+  }
+  growth_left_ = other.growth_left_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashTable(
+    HashTable&& other) noexcept
+    : ctrl_(std::exchange(other.ctrl_, nullptr)),
+      keys_(std::exchange(other.keys_, nullptr)),
+      vals_(std::exchange(other.vals_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      growth_left_(std::exchange(other.growth_left_, 0)),
+      ctrl_alloc_(std::move(other.ctrl_alloc_)),
+      key_alloc_(std::move(other.key_alloc_)),
+      val_alloc_(std::move(other.val_alloc_)),
+      hash_(std::move(other.hash_)),
+      equal_(std::move(other.equal_)) {}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::~HashTable() {
+  DestroyAll();
+  Release();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>&
+HashTable<Key, T, Hash, KeyEqual, Allocator>::operator=(
+    const HashTable& other) {
+  if (this != &other) {
+    HashTable<Key, T, Hash, KeyEqual, Allocator> temp(
+        other, std::allocator_traits<
+                   Allocator>::propagate_on_container_copy_assignment::value
+                   ? other.GetAllocator()
+                   : GetAllocator());
+    Swap(temp);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>&
+HashTable<Key, T, Hash, KeyEqual, Allocator>::operator=(
+    HashTable&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  DestroyAll();
+  Release();
+  if (!std::allocator_traits<
+          Allocator>::propagate_on_container_move_assignment::value &&
+      GetAllocator() != other.GetAllocator()) {
+    // Our allocator stays and cannot free other's arrays.
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    Reserve(other.size_);
+    for (iterator it = other.Begin(); it != other.End(); ++it) {
+      MoveInto(*this, it);
+    }
+    other.DestroyAll();
+    other.Release();
+  } else {
+    ctrl_alloc_ = std::move(other.ctrl_alloc_);
+    key_alloc_ = std::move(other.key_alloc_);
+    val_alloc_ = std::move(other.val_alloc_);
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(keys_, other.keys_);
+    std::swap(vals_, other.vals_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::Begin() const noexcept {
+  if (capacity_ == 0) {
+    return iterator();
+  }
+  iterator it = IteratorAt(0);
+  it.SkipFree();
+  return it;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::End() const noexcept {
+  return capacity_ == 0 ? iterator() : IteratorAt(capacity_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::CBegin() const noexcept {
+  return Begin();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::CEnd() const noexcept {
+  return End();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool HashTable<Key, T, Hash, KeyEqual, Allocator>::Empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::Size() const noexcept {
+  return size_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::MaxSize() const noexcept {
+  return MaxLoad(key_traits::max_size(key_alloc_));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::allocator_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::GetAllocator() const noexcept {
+  return Allocator(key_alloc_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::hasher
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashFunction() const {
+  return hash_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::key_equal
+HashTable<Key, T, Hash, KeyEqual, Allocator>::KeyEq() const {
+  return equal_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::BucketCount() const noexcept {
+  return capacity_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+float HashTable<Key, T, Hash, KeyEqual, Allocator>::LoadFactor()
+    const noexcept {
+  return capacity_ == 0 ? 0.0f
+                        : static_cast<float>(size_) /
+                              static_cast<float>(capacity_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Reserve(size_type count) {
+  if (count > size_ + growth_left_) {
+    Resize(CapacityFor(count));
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Rehash(size_type count) {
+  size_type capacity = CapacityFor(size_);
+  if (count > 0) {
+    size_type wanted = kWidth;
+    while (wanted < count) {
+      wanted *= 2;
+    }
+    capacity = std::max(capacity, wanted);
+  }
+  if (capacity == 0) {
+    Release();
+  } else {
+    Resize(capacity);
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Clear() noexcept {
+  if (capacity_ == 0) {
+    return;
+  }
+  DestroyAll();
+  std::fill(ctrl_, ctrl_ + capacity_, kHashEmpty);
+  size_ = 0;
+  growth_left_ = MaxLoad(capacity_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Swap(
+    HashTable& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(keys_, other.keys_);
+  std::swap(vals_, other.vals_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(ctrl_alloc_, other.ctrl_alloc_);
+  std::swap(key_alloc_, other.key_alloc_);
+  std::swap(val_alloc_, other.val_alloc_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Merge(HashTable& other) {
+  if (this == &other) {
+    return;
+  }
+  // Erasure moves no other element, so the walk over other goes on from
+  // the slot just freed.
+  for (iterator it = other.Begin(); it != other.End(); ++it) {
+    if (MoveInto(*this, it)) {
+      other.Erase(it);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Erase(iterator pos) {
+  size_type index = IndexOf(pos);
+  Destroy(index);
+  --size_;
+  if (HashGroup(ctrl_ + (index & ~(kWidth - 1))).MatchEmpty() != 0) {
+    ctrl_[index] = kHashEmpty;
+    ++growth_left_;
+  } else {
+    ctrl_[index] = kHashDeleted;
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Erase(iterator first,
+                                                         iterator last) {
+  while (first != last) {
+    iterator next = first;
+    ++next;
+    Erase(first);
+    first = next;
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::Find(const Key& key) const {
+  size_type index = FindIndex(key, HashOf(key));
+  return index == capacity_ ? End() : IteratorAt(index);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool HashTable<Key, T, Hash, KeyEqual, Allocator>::Contains(
+    const Key& key) const {
+  return FindIndex(key, HashOf(key)) != capacity_;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::Count(const Key& key) const {
+  return Contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::EqualRange(
+    const Key& key) const {
+  iterator first = Find(key);
+  iterator last = first;
+  if (first != End()) {
+    ++last;
+  }
+  return {first, last};
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... KeyArgs, typename... ValArgs>
+std::pair<typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+HashTable<Key, T, Hash, KeyEqual, Allocator>::EmplaceUnique(
+    const Key& key, std::tuple<KeyArgs...> key_args,
+    std::tuple<ValArgs...> val_args) {
+  size_type hash = HashOf(key);
+  size_type index = FindIndex(key, hash);
+  if (index != capacity_) {
+    return {IteratorAt(index), false};
+  }
+  // A deleted slot can be reused without growing; an empty one needs room
+  // under the load limit.
+  if (capacity_ != 0) {
+    index = FindFree(hash);
+  }
+  if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[index] == kHashEmpty)) {
+    Grow();
+    index = FindFree(hash);
+  }
+  ConstructAt(keys_ + index, std::move(key_args));
+  if constexpr (!std::is_void_v<T>) {
+    try {
+      ConstructAt(vals_ + index, std::move(val_args));
+    } catch (...) {
+      keys_[index].~Key();
+      throw;
+    }
+  } else {
+    (void)val_args;
+  }
+  if (ctrl_[index] == kHashEmpty) {
+    --growth_left_;
+  }
+  ctrl_[index] = H2(hash);
+  ++size_;
+  return {IteratorAt(index), true};
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::HashOf(const Key& key) const {
+  std::uint64_t mixed =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_type>(mixed ^ (mixed >> 32));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::CapacityFor(
+    size_type count) noexcept {
+  if (count == 0) {
+    return 0;
+  }
+  size_type capacity = kWidth;
+  while (MaxLoad(capacity) < count) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::FindIndex(const Key& key,
+                                                        size_type hash) const {
+  if (capacity_ == 0) {
+    return capacity_;
+  }
+  // Steps of 1, 2, 3, ... groups visit every group of a power-of-two
+  // count, and the load limit leaves some group with an empty slot.
+  size_type mask = capacity_ / kWidth - 1;
+  size_type group = H1(hash) & mask;
+  for (size_type step = 1;; ++step) {
+    const signed char* ctrl = ctrl_ + group * kWidth;
+    HashGroup bytes(ctrl);
+    for (unsigned match = bytes.Match(H2(hash)); match != 0;
+         match &= match - 1) {
+      size_type index = group * kWidth + LowestBit(match);
+      if (equal_(keys_[index], key)) {
+        return index;
+      }
+    }
+    if (bytes.MatchEmpty() != 0) {
+      return capacity_;
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::FindFree(
+    size_type hash) const noexcept {
+  size_type mask = capacity_ / kWidth - 1;
+  size_type group = H1(hash) & mask;
+  for (size_type step = 1;; ++step) {
+    unsigned free = HashGroup(ctrl_ + group * kWidth).MatchFree();
+    if (free != 0) {
+      return group * kWidth + LowestBit(free);
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, T, Hash, KeyEqual, Allocator>::IteratorAt(
+    size_type index) const noexcept {
+  if constexpr (std::is_void_v<T>) {
+    return iterator(ctrl_ + index, keys_ + index, nullptr);
+  } else {
+    return iterator(ctrl_ + index, keys_ + index, vals_ + index);
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, T, Hash, KeyEqual, Allocator>::IndexOf(
+    iterator pos) const noexcept {
+  return static_cast<size_type>(pos.GetCtrl() - ctrl_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Allocate(
+    size_type capacity) {
+  // One more control byte for the sentinel.
+  signed char* ctrl = ctrl_traits::allocate(ctrl_alloc_, capacity + 1);
+  Key* keys = nullptr;
+  stored_type* vals = nullptr;
+  try {
+    keys = key_traits::allocate(key_alloc_, capacity);
+    if constexpr (!std::is_void_v<T>) {
+      vals = val_traits::allocate(val_alloc_, capacity);
+    }
+  } catch (...) {
+    if (keys != nullptr) {
+      key_traits::deallocate(key_alloc_, keys, capacity);
+    }
+    ctrl_traits::deallocate(ctrl_alloc_, ctrl, capacity + 1);
+    throw;
+  }
+  std::fill(ctrl, ctrl + capacity, kHashEmpty);
+  ctrl[capacity] = kHashSentinel;
+  ctrl_ = ctrl;
+  keys_ = keys;
+  vals_ = vals;
+  capacity_ = capacity;
+  growth_left_ = MaxLoad(capacity);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Deallocate(
+    signed char* ctrl, Key* keys, stored_type* vals,
+    size_type capacity) noexcept {
+  if (capacity == 0) {
+    return;
+  }
+  ctrl_traits::deallocate(ctrl_alloc_, ctrl, capacity + 1);
+  key_traits::deallocate(key_alloc_, keys, capacity);
+  if constexpr (!std::is_void_v<T>) {
+    val_traits::deallocate(val_alloc_, vals, capacity);
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Release() noexcept {
+  Deallocate(ctrl_, keys_, vals_, capacity_);
+  ctrl_ = nullptr;
+  keys_ = nullptr;
+  vals_ = nullptr;
+  capacity_ = 0;
+  size_ = 0;
+  growth_left_ = 0;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::DestroyAll() noexcept {
+  for (size_type i = 0; i < capacity_ && size_ > 0; ++i) {
+    if (ctrl_[i] >= 0) {
+      Destroy(i);
+      --size_;
+    }
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Destroy(
+    size_type index) noexcept {
+  keys_[index].~Key();
+  if constexpr (!std::is_void_v<T>) {
+    vals_[index].~T();
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Resize(size_type capacity) {
+  signed char* old_ctrl = ctrl_;
+  Key* old_keys = keys_;
+  stored_type* old_vals = vals_;
+  size_type old_capacity = capacity_;
+  Allocate(capacity);
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (old_ctrl[i] < 0) {
+      continue;
+    }
+    size_type hash = HashOf(old_keys[i]);
+    size_type index = FindFree(hash);
+    ::new (static_cast<void*>(keys_ + index)) Key(std::move(old_keys[i]));
+    old_keys[i].~Key();
+    if constexpr (!std::is_void_v<T>) {
+      ::new (static_cast<void*>(vals_ + index)) T(std::move(old_vals[i]));
+      old_vals[i].~T();
+    }
+    ctrl_[index] = H2(hash);
+  }
+  growth_left_ -= size_;
+  Deallocate(old_ctrl, old_keys, old_vals, old_capacity);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void HashTable<Key, T, Hash, KeyEqual, Allocator>::Grow() {
+  if (capacity_ == 0) {
+    Resize(kWidth);
+  } else if (size_ * 2 >= MaxLoad(capacity_)) {
+    Resize(capacity_ * 2);
+  } else {
+    Resize(capacity_);
+  }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool HashTable<Key, T, Hash, KeyEqual, Allocator>::MoveInto(HashTable& target,
+                                                            iterator source) {
+  Key& key = const_cast<Key&>(source.GetKey());
+  if constexpr (std::is_void_v<T>) {
+    return target
+        .EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                       std::tuple<>())
+        .second;
+  } else {
+    return target
+        .EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                       std::forward_as_tuple(std::move(ValueAt(source))))
+        .second;
+  }
+}
+
+}  // namespace s21
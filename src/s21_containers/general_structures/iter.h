@@ -5,14 +5,14 @@
 
 namespace s21 {
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Augment = NoAugment>
 class Iter {
  public:
   using value_type = T;
   using key_type = Key;
 
   Iter() noexcept;
-  Iter(Node<Key, T>* other) noexcept;
+  Iter(Node<Key, T, Augment>* other) noexcept;
   Iter(const Iter& other) noexcept;
   ~Iter() {}
 
@@ -24,12 +24,15 @@ class Iter {
 
   const Key& GetKey() const { return current_->key_; }
 
-  const T& GetVal() const { return current_->val_; }
+  template <typename V = T>
+  const V& GetVal() const {
+    return current_->val_;
+  }
 
-  Node<Key, T>* getCurrent() const { return current_; }
+  Node<Key, T, Augment>* getCurrent() const { return current_; }
 
  protected:
-  Node<Key, T>* current_;
+  Node<Key, T, Augment>* current_;
 };
 
 }  // namespace s21
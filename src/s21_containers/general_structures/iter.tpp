@@ -3,28 +3,31 @@
 
 namespace s21 {
 
-template <typename Key, typename T>
-Iter<Key, T>::Iter() noexcept : current_(nullptr) {}
+template <typename Key, typename T, typename Augment>
+Iter<Key, T, Augment>::Iter() noexcept : current_(nullptr) {}
 
-template <typename Key, typename T>
-Iter<Key, T>::Iter(Node<Key, T>* other) noexcept : current_(other) {}
+template <typename Key, typename T, typename Augment>
+Iter<Key, T, Augment>::Iter(Node<Key, T, Augment>* other) noexcept
+    : current_(other) {}
 
-template <typename Key, typename T>
-Iter<Key, T>::Iter(const Iter& other) noexcept : current_(other.current_) {}
+template <typename Key, typename T, typename Augment>
+Iter<Key, T, Augment>::Iter(const Iter& other) noexcept
+    : current_(other.current_) {}
 
-template <typename Key, typename T>
-bool Iter<Key, T>::operator==(const Iter& other) const noexcept {
+template <typename Key, typename T, typename Augment>
+bool Iter<Key, T, Augment>::operator==(const Iter& other) const noexcept {
   return current_ == other.current_;
 }
 
-template <typename Key, typename T>
-Iter<Key, T> Iter<Key, T>::operator=(const Iter& other) noexcept {
+template <typename Key, typename T, typename Augment>
+Iter<Key, T, Augment> Iter<Key, T, Augment>::operator=(
+    const Iter& other) noexcept {
   current_ = other.current_;
   return *this;
 }
 
-template <typename Key, typename T>
-void Iter<Key, T>::operator++() noexcept {
+template <typename Key, typename T, typename Augment>
+void Iter<Key, T, Augment>::operator++() noexcept {
   if (current_->end_) {
     return;
   }
@@ -33,8 +36,8 @@ void Iter<Key, T>::operator++() noexcept {
     while (current_->left_ && current_->left_->end_ != true)
       current_ = current_->left_;
   } else {
-    Node<Key, T>* save = current_;
-    Node<Key, T>* p = current_->parent_;
+    Node<Key, T, Augment>* save = current_;
+    Node<Key, T, Augment>* p = current_->parent_;
 
     while (p != nullptr && current_ == p->right_) {
       current_ = p;
@@ -44,8 +47,8 @@ void Iter<Key, T>::operator++() noexcept {
   }
 }
 
-template <typename Key, typename T>
-void Iter<Key, T>::operator--() noexcept {
+template <typename Key, typename T, typename Augment>
+void Iter<Key, T, Augment>::operator--() noexcept {
   if (current_->end_) {
     current_ = current_->parent_;
     return;
@@ -55,8 +58,8 @@ void Iter<Key, T>::operator--() noexcept {
     while (current_->right_ && current_->right_->end_ != true)
       current_ = current_->right_;
   } else {
-    Node<Key, T>* save = current_;
-    Node<Key, T>* p = current_->parent_;
+    Node<Key, T, Augment>* save = current_;
+    Node<Key, T, Augment>* p = current_->parent_;
 
     while (current_ == p->left_ && p->left_->end_ != true) {
       current_ = p;
@@ -71,8 +74,8 @@ void Iter<Key, T>::operator--() noexcept {
   }
 }
 
-template <typename Key, typename T>
-bool Iter<Key, T>::operator!=(const Iter& other) const noexcept {
+template <typename Key, typename T, typename Augment>
+bool Iter<Key, T, Augment>::operator!=(const Iter& other) const noexcept {
   return current_ != other.current_;
 }
 
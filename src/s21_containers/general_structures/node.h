@@ -1,33 +1,250 @@
 #ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_H_
 #define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 enum NodeColors { RED, BLACK };
 
 namespace s21 {
 
+// Augment policies let a tree keep extra data in every node, derived from
+// the node's children. Node inherits from its policy, so the data lives in
+// the node itself and the empty default costs no memory. After the links
+// of a node change, the tree calls Augment::Update(node) on it and then on
+// every ancestor whose subtree changed. A default constructed policy has to
+// describe an empty subtree, as leaf sentinels are never updated.
+struct NoAugment {
+  template <typename NodeType>
+  static void Update(NodeType*) noexcept {}
+};
+
+// Keeps the number of elements in every subtree, which gives O(log n) rank
+// and select, see Container::Rank.
+struct OrderStatistic {
+  template <typename NodeType>
+  static void Update(NodeType* node) noexcept {
+    node->size_ = node->left_->size_ + node->right_->size_ + 1;
+  }
+
+  std::size_t size_ = 0;
+};
+
+// What RangeAggregate folds: the mapped value, or the key in a set.
+template <typename NodeType>
+const auto& FoldedValue(const NodeType* node) noexcept {
+  if constexpr (std::is_void_v<typename NodeType::mapped_type>) {
+    return node->key_;
+  } else {
+    return node->val_;
+  }
+}
+
+// Keeps the mapped values of every subtree, or the keys of a set, folded
+// with Monoid::Combine in key order, which gives O(log n) range queries,
+// see Container::Aggregate. Monoid provides value_type, Identity() and an
+// associative Combine(a, b) that must not throw; values are converted to
+// value_type to be combined.
+template <typename Monoid>
+struct RangeAggregate {
+  using monoid_type = Monoid;
+
+  template <typename NodeType>
+  static void Update(NodeType* node) noexcept {
+    node->aggregate_ = Monoid::Combine(
+        Monoid::Combine(node->left_->aggregate_, FoldedValue(node)),
+        node->right_->aggregate_);
+  }
+
+  typename Monoid::value_type aggregate_ = Monoid::Identity();
+};
+
+template <typename V>
+struct SumMonoid {
+  using value_type = V;
+  static V Identity() noexcept { return V(); }
+  static V Combine(const V& a, const V& b) noexcept { return a + b; }
+};
+
+template <typename V>
+struct MinMonoid {
+  using value_type = V;
+  static V Identity() noexcept {
+    return std::numeric_limits<V>::has_infinity
+               ? std::numeric_limits<V>::infinity()
+               : std::numeric_limits<V>::max();
+  }
+  static V Combine(const V& a, const V& b) noexcept { return std::min(a, b); }
+};
+
+template <typename V>
+struct MaxMonoid {
+  using value_type = V;
+  static V Identity() noexcept {
+    return std::numeric_limits<V>::has_infinity
+               ? -std::numeric_limits<V>::infinity()
+               : std::numeric_limits<V>::lowest();
+  }
+  static V Combine(const V& a, const V& b) noexcept { return std::max(a, b); }
+};
+
+// Selects the Node constructor that builds a sentinel, see NodeValue.
+struct SentinelTag {};
+
+// Constructs a V at place from the elements of args, like
+// std::make_from_tuple.
+template <typename V, typename Tuple>
+void ConstructAt(V* place, Tuple&& args) {
+  std::apply(
+      [place](auto&&... arg) {
+        ::new (static_cast<void*>(place))
+            V(std::forward<decltype(arg)>(arg)...);
+      },
+      std::forward<Tuple>(args));
+}
+
+// Holds the key and the value of a Node. They live in unions so that a
+// sentinel can leave them unconstructed: sentinels are never destroyed,
+// which keeps key and value from needing a default constructor and the
+// containers from allocating their End() node. The destructor stays
+// trivial when those of Key and T are. A set has T = void and no value.
+template <typename Key, typename T,
+          bool = std::is_trivially_destructible_v<Key> &&
+                 std::disjunction_v<std::is_void<T>,
+                                    std::is_trivially_destructible<T>>>
+struct NodeValue {
+  union {
+    Key key_;
+  };
+  union {
+    T val_;
+  };
+
+  explicit NodeValue(SentinelTag) noexcept {}
+  template <typename KeyTuple, typename ValTuple>
+  NodeValue(KeyTuple&& key_args, ValTuple&& val_args) {
+    ConstructAt(std::addressof(key_), std::forward<KeyTuple>(key_args));
+    ConstructAt(std::addressof(val_), std::forward<ValTuple>(val_args));
+  }
+};
+
 template <typename Key, typename T>
-class Node {
+struct NodeValue<Key, T, false> {
+  union {
+    Key key_;
+  };
+  union {
+    T val_;
+  };
+
+  explicit NodeValue(SentinelTag) noexcept {}
+  template <typename KeyTuple, typename ValTuple>
+  NodeValue(KeyTuple&& key_args, ValTuple&& val_args) {
+    ConstructAt(std::addressof(key_), std::forward<KeyTuple>(key_args));
+    try {
+      ConstructAt(std::addressof(val_), std::forward<ValTuple>(val_args));
+    } catch (...) {
+      key_.~Key();
+      throw;
+    }
+  }
+
+  ~NodeValue() {
+    key_.~Key();
+    val_.~T();
+  }
+};
+
+template <typename Key>
+struct NodeValue<Key, void, true> {
+  union {
+    Key key_;
+  };
+
+  explicit NodeValue(SentinelTag) noexcept {}
+  template <typename KeyTuple, typename ValTuple>
+  NodeValue(KeyTuple&& key_args, ValTuple&&) {
+    ConstructAt(std::addressof(key_), std::forward<KeyTuple>(key_args));
+  }
+};
+
+template <typename Key>
+struct NodeValue<Key, void, false> {
+  union {
+    Key key_;
+  };
+
+  explicit NodeValue(SentinelTag) noexcept {}
+  template <typename KeyTuple, typename ValTuple>
+  NodeValue(KeyTuple&& key_args, ValTuple&&) {
+    ConstructAt(std::addressof(key_), std::forward<KeyTuple>(key_args));
+  }
+
+  ~NodeValue() { key_.~Key(); }
+};
+
+template <typename Key, typename T, typename Augment = NoAugment>
+class Node : public Augment, public NodeValue<Key, T> {
  public:
-  Key key_;
-  T val_;
-  Node<Key, T>* left_;
-  Node<Key, T>* right_;
-  Node<Key, T>* parent_;
+  using mapped_type = T;
+
+  Node<Key, T, Augment>* left_;
+  Node<Key, T, Augment>* right_;
+  Node<Key, T, Augment>* parent_;
   NodeColors color_;
   bool end_;
 
-  Node()
-      : key_(),
-        val_(),
+  Node() : Node(std::piecewise_construct, std::tuple<>(), std::tuple<>()) {}
+
+  // Builds key_ and val_ directly from the two argument tuples, like the
+  // piecewise constructor of std::pair, so neither is copied afterwards.
+  template <typename... KeyArgs, typename... ValArgs>
+  Node(std::piecewise_construct_t, std::tuple<KeyArgs...> key_args,
+       std::tuple<ValArgs...> val_args)
+      : NodeValue<Key, T>(std::move(key_args), std::move(val_args)),
         left_(nullptr),
         right_(nullptr),
         parent_(nullptr),
         color_(RED),
         end_(false) {}
 
+  // A black end_ node with no key or value, to be used as a leaf or as
+  // End(). It must not be copied, moved or destroyed.
+  explicit Node(SentinelTag tag) noexcept
+      : NodeValue<Key, T>(tag),
+        left_(nullptr),
+        right_(nullptr),
+        parent_(nullptr),
+        color_(BLACK),
+        end_(true) {}
+
+  // Arguments that copy or move the value of node into another node; none
+  // in a set.
+  static auto CopyValArgs(const Node& node) noexcept {
+    if constexpr (std::is_void_v<T>) {
+      return std::tuple<>();
+    } else {
+      return std::forward_as_tuple(node.val_);
+    }
+  }
+  static auto MoveValArgs(Node& node) noexcept {
+    if constexpr (std::is_void_v<T>) {
+      return std::tuple<>();
+    } else {
+      return std::forward_as_tuple(std::move(node.val_));
+    }
+  }
+
   Node(const Node& other)
-      : key_(other.key_),
-        val_(other.val_),
+      : Augment(other),
+        NodeValue<Key, T>(std::forward_as_tuple(other.key_),
+                          CopyValArgs(other)),
         left_(nullptr),
         right_(nullptr),
         parent_(nullptr),
@@ -35,15 +252,17 @@ class Node {
         end_(other.end_) {}
 
   Node(Node&& other)
-      : key_(std::move(other.key_)),
-        val_(std::move(other.val_)),
+      : NodeValue<Key, T>(std::forward_as_tuple(std::move(other.key_)),
+                          MoveValArgs(other)),
         left_(other.left_),
         right_(other.right_),
         parent_(other.parent_),
         color_(other.color_),
         end_(other.end_) {
     other.key_ = Key();
-    other.val_ = T();
+    if constexpr (!std::is_void_v<T>) {
+      other.val_ = T();
+    }
     other.color_ = RED;
     other.left_ = nullptr;
     other.right_ = nullptr;
@@ -53,8 +272,10 @@ class Node {
 
   Node& operator=(const Node& other) {
     if (this != &other) {
-      key_ = other.key_;
-      val_ = other.val_;
+      this->key_ = other.key_;
+      if constexpr (!std::is_void_v<T>) {
+        this->val_ = other.val_;
+      }
       color_ = other.color_;
       end_ = other.end_;
       parent_ = other.parent_;
@@ -66,15 +287,19 @@ class Node {
 
   Node& operator=(Node&& other) {
     if (this != &other) {
-      key_ = std::move(other.key_);
-      val_ = std::move(other.val_);
+      this->key_ = std::move(other.key_);
+      if constexpr (!std::is_void_v<T>) {
+        this->val_ = std::move(other.val_);
+      }
       color_ = other.color_;
       end_ = other.end_;
       left_ = other.left_;
       right_ = other.right_;
       parent_ = other.parent_;
       other.key_ = Key();
-      other.val_ = T();
+      if constexpr (!std::is_void_v<T>) {
+        other.val_ = T();
+      }
       other.color_ = RED;
       other.left_ = nullptr;
       other.right_ = nullptr;
@@ -84,7 +309,7 @@ class Node {
     return *this;
   }
 
-  ~Node() {}
+  ~Node() = default;
 };
 }  // namespace s21
 
@@ -0,0 +1,105 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_HANDLE_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_HANDLE_H_
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "node.h"
+#include "node_pool.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Augment>
+class Container;
+
+// Owns a node taken out of a Set or Map by Extract. The key may be changed
+// freely until the node is inserted again, and moving it into a container
+// whose allocator compares equal relinks the node without allocating.
+//
+// The handle shares ownership of the slabs the node lives in, so it stays
+// valid after the source container is destroyed. A node dropped together
+// with its handle is destroyed and its slot goes back to the source
+// container's pool for reuse (NodePool::Recycle).
+template <typename Key, typename T, typename Allocator,
+          typename Augment = NoAugment>
+class NodeHandle {
+ private:
+  using pool_type = NodePool<Node<Key, T, Augment>, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using allocator_type = Allocator;
+
+  NodeHandle() noexcept
+      : node_(nullptr), group_(nullptr), bin_(nullptr), alloc_() {}
+  NodeHandle(NodeHandle&& other) noexcept
+      : node_(std::exchange(other.node_, nullptr)),
+        group_(std::move(other.group_)),
+        bin_(std::move(other.bin_)),
+        alloc_(std::move(other.alloc_)) {}
+  NodeHandle(const NodeHandle& other) = delete;
+  ~NodeHandle() { Reset(); }
+
+  NodeHandle& operator=(NodeHandle&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      node_ = std::exchange(other.node_, nullptr);
+      group_ = std::move(other.group_);
+      bin_ = std::move(other.bin_);
+      alloc_ = std::move(other.alloc_);
+    }
+    return *this;
+  }
+  NodeHandle& operator=(const NodeHandle& other) = delete;
+
+  bool Empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  Key& GetKey() const { return node_->key_; }
+  template <typename V = T>
+  V& GetVal() const {
+    return node_->val_;
+  }
+  allocator_type GetAllocator() const { return allocator_type(*alloc_); }
+
+ private:
+  template <typename, typename, typename, typename, typename>
+  friend class Container;
+
+  NodeHandle(Node<Key, T, Augment>* node, typename pool_type::group_ptr group,
+             typename pool_type::bin_ptr bin,
+             const typename pool_type::allocator_type& alloc)
+      : node_(node),
+        group_(std::move(group)),
+        bin_(std::move(bin)),
+        alloc_(alloc) {}
+
+  // Gives up ownership of the node, e.g. once it is linked into a tree.
+  Node<Key, T, Augment>* Release() noexcept {
+    group_.reset();
+    bin_.reset();
+    alloc_.reset();
+    return std::exchange(node_, nullptr);
+  }
+
+  void Reset() noexcept {
+    if (node_ != nullptr) {
+      pool_type::Recycle(bin_, *alloc_, node_);
+    }
+    Release();
+  }
+
+  Node<Key, T, Augment>* node_;
+  typename pool_type::group_ptr group_;
+  typename pool_type::bin_ptr bin_;
+  // Empty while the handle is empty, as allocators need not be default
+  // constructible.
+  std::optional<typename pool_type::allocator_type> alloc_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_HANDLE_H_
@@ -0,0 +1,161 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_POOL_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Slab allocator for tree nodes. Memory is taken from Allocator in slabs of
+// many nodes and freed nodes are kept on a free list for reuse, so inserts
+// and erases do not go to the allocator one node at a time. All slabs are
+// released together when the pool is destroyed.
+//
+// Nodes may be handed over to another pool (Retain), e.g. when a tree
+// relinks nodes it took from another tree. The donor's slabs are then sealed
+// into an immutable shared group that stays alive while any pool still
+// retains it, so relinked nodes never have to be copied.
+//
+// Nodes handed out through node handles may be dropped anywhere, possibly
+// on another thread. Their slots come back through a lock-free bin the pool
+// shares with the handles (Recycle), which the pool empties into its free
+// list once it runs out of free slots.
+template <typename NodeType, typename Allocator = std::allocator<NodeType>>
+class NodePool {
+ private:
+  union Slot;
+  struct Slab;
+  struct SlabGroup;
+  struct Bin;
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+  using slab_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slab>;
+  using group_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<SlabGroup>;
+  using bin_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Bin>;
+
+ public:
+  using size_type = std::size_t;
+  using allocator_type = slot_allocator;
+  // Shared ownership of sealed slabs; holding one keeps their nodes valid.
+  using group_ptr = std::shared_ptr<const SlabGroup>;
+  // Shared ownership of the bin that dropped nodes' slots go back through.
+  using bin_ptr = std::shared_ptr<Bin>;
+
+ private:
+  using group_ptr_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<group_ptr>;
+
+ public:
+  NodePool() noexcept;
+  explicit NodePool(const Allocator& alloc) noexcept;
+  NodePool(const NodePool& other) = delete;
+  NodePool(NodePool&& other) noexcept;
+  ~NodePool();
+
+  NodePool& operator=(const NodePool& other) = delete;
+  NodePool& operator=(NodePool&& other) noexcept;
+
+  template <typename... Args>
+  NodeType* Create(Args&&... args);
+  void Destroy(NodeType* node) noexcept;
+  // Ends the lifetime of node without taking its slot back, for nodes whose
+  // slabs are about to be released as a whole.
+  void Discard(NodeType* node) noexcept;
+  // True when Discard does nothing, so such nodes need not even be visited.
+  static constexpr bool DiscardIsNoop() noexcept;
+
+  void Reserve(size_type count);
+  size_type Available() const noexcept;
+  // Slots in this pool's slabs and in the groups it retains: the memory a
+  // pool that retains this one would keep alive. Slabs reachable through
+  // several groups are counted once per group.
+  size_type Capacity() const noexcept;
+  void Swap(NodePool& other) noexcept;
+  allocator_type GetAllocator() const noexcept;
+
+  // Keeps donor's memory alive for as long as this pool lives, so nodes
+  // created by donor may be destroyed through this pool. The allocators of
+  // both pools must compare equal.
+  void Retain(NodePool& donor);
+  void Retain(group_ptr group);
+  // Seals this pool's slabs into a shared group, which keeps every node
+  // created so far valid even after the pool is gone. Allocates only when
+  // new slabs were added since the last call.
+  group_ptr Share();
+  // The bin this pool takes slots back from. It is created on first use.
+  bin_ptr SharedBin();
+  // Destroys node and puts its slot into bin, from which the pool that
+  // handed the bin out takes it back. That pool must have created node, or
+  // retained it, before giving the bin out.
+  static void Recycle(const bin_ptr& bin, allocator_type& alloc,
+                      NodeType* node) noexcept;
+
+ private:
+  union Slot {
+    Slot* next_;
+    alignas(NodeType) unsigned char storage_[sizeof(NodeType)];
+  };
+
+  struct Slab {
+    Slot* slots_;
+    size_type count_;
+  };
+
+  struct SlabGroup {
+    SlabGroup(const slot_allocator& alloc,
+              std::vector<Slab, slab_allocator>&& slabs,
+              std::vector<group_ptr, group_ptr_allocator>&& children);
+    ~SlabGroup();
+
+    slot_allocator alloc_;
+    std::vector<Slab, slab_allocator> slabs_;
+    std::vector<group_ptr, group_ptr_allocator> children_;
+    // Slots in slabs_ and in children_.
+    size_type slots_;
+  };
+
+  struct Bin {
+    std::atomic<Slot*> head_{nullptr};
+  };
+
+  static constexpr size_type kFirstSlabSize = 16;
+  static constexpr size_type kMaxSlabSize = 4096;
+
+  template <typename A, typename = void>
+  struct HasDestroy : std::false_type {};
+  template <typename A>
+  struct HasDestroy<A, std::void_t<decltype(std::declval<A&>().destroy(
+                           std::declval<NodeType*>()))>> : std::true_type {};
+
+  Slot* Allocate();
+  void AddSlab(size_type count);
+  // Moves the slots in bin_ onto the free list.
+  void Reclaim() noexcept;
+  void Release() noexcept;
+
+  slot_allocator alloc_;
+  std::vector<Slab, slab_allocator> slabs_;
+  // Sealed slabs this pool or its donors handed out nodes from.
+  std::vector<group_ptr, group_ptr_allocator> retained_;
+  bin_ptr bin_;
+  Slot* free_;
+  Slot* cursor_;
+  Slot* slab_end_;
+  size_type free_count_;
+  size_type next_slab_size_;
+};
+
+}  // namespace s21
+
+#include "node_pool.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_NODE_POOL_H_
@@ -0,0 +1,324 @@
+#include "node_pool.h"
+
+namespace s21 {
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::NodePool() noexcept : NodePool(Allocator()) {}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::NodePool(const Allocator& alloc) noexcept
+    : alloc_(alloc),
+      slabs_(slab_allocator(alloc)),
+      retained_(group_ptr_allocator(alloc)),
+      bin_(nullptr),
+      free_(nullptr),
+      cursor_(nullptr),
+      slab_end_(nullptr),
+      free_count_(0),
+      next_slab_size_(kFirstSlabSize) {}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::NodePool(NodePool&& other) noexcept
+    : alloc_(std::move(other.alloc_)),
+      slabs_(std::move(other.slabs_)),
+      retained_(std::move(other.retained_)),
+      bin_(std::move(other.bin_)),
+      free_(other.free_),
+      cursor_(other.cursor_),
+      slab_end_(other.slab_end_),
+      free_count_(other.free_count_),
+      next_slab_size_(other.next_slab_size_) {
+  other.slabs_.clear();
+  other.retained_.clear();
+  other.free_ = nullptr;
+  other.cursor_ = nullptr;
+  other.slab_end_ = nullptr;
+  other.free_count_ = 0;
+  other.next_slab_size_ = kFirstSlabSize;
+}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::~NodePool() {
+  Release();
+}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>& NodePool<NodeType, Allocator>::operator=(
+    NodePool&& other) noexcept {
+  if (this != &other) {
+    NodePool<NodeType, Allocator> tmp(std::move(other));
+    Swap(tmp);
+  }
+  return *this;
+}
+
+template <typename NodeType, typename Allocator>
+template <typename... Args>
+NodeType* NodePool<NodeType, Allocator>::Create(Args&&... args) {
+  Slot* slot = Allocate();
+  NodeType* node = reinterpret_cast<NodeType*>(slot->storage_);
+  try {
+    slot_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    return node;
+  } catch (...) {
+    slot->next_ = free_;
+    free_ = slot;
+    ++free_count_;
+    throw;
+  }
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Destroy(NodeType* node) noexcept {
+  if (node == nullptr) {
+    return;
+  }
+  slot_traits::destroy(alloc_, node);
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->next_ = free_;
+  free_ = slot;
+  ++free_count_;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Discard(NodeType* node) noexcept {
+  if constexpr (!DiscardIsNoop()) {
+    slot_traits::destroy(alloc_, node);
+  }
+}
+
+template <typename NodeType, typename Allocator>
+constexpr bool NodePool<NodeType, Allocator>::DiscardIsNoop() noexcept {
+  // std::allocator still declares destroy in C++17, but only to call the
+  // destructor.
+  return std::is_trivially_destructible_v<NodeType> &&
+         (std::is_same_v<slot_allocator, std::allocator<Slot>> ||
+          !HasDestroy<slot_allocator>::value);
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Reserve(size_type count) {
+  if (count > Available()) {
+    Reclaim();
+  }
+  size_type available = Available();
+  if (count > available) {
+    // A small reservation still gets a full slab, so reserving a few nodes
+    // at a time does not splinter the pool into tiny slabs.
+    AddSlab(std::max(count - available, next_slab_size_));
+    if (next_slab_size_ < kMaxSlabSize) {
+      next_slab_size_ *= 2;
+    }
+  }
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::size_type
+NodePool<NodeType, Allocator>::Available() const noexcept {
+  return free_count_ + static_cast<size_type>(slab_end_ - cursor_);
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::size_type
+NodePool<NodeType, Allocator>::Capacity() const noexcept {
+  size_type slots = 0;
+  for (const Slab& slab : slabs_) {
+    slots += slab.count_;
+  }
+  for (const group_ptr& group : retained_) {
+    slots += group->slots_;
+  }
+  return slots;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Swap(NodePool& other) noexcept {
+  std::swap(alloc_, other.alloc_);
+  slabs_.swap(other.slabs_);
+  retained_.swap(other.retained_);
+  bin_.swap(other.bin_);
+  std::swap(free_, other.free_);
+  std::swap(cursor_, other.cursor_);
+  std::swap(slab_end_, other.slab_end_);
+  std::swap(free_count_, other.free_count_);
+  std::swap(next_slab_size_, other.next_slab_size_);
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::allocator_type
+NodePool<NodeType, Allocator>::GetAllocator() const noexcept {
+  return alloc_;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Retain(NodePool& donor) {
+  if (this == &donor) {
+    return;
+  }
+  Retain(donor.Share());
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Retain(group_ptr group) {
+  if (group == nullptr) {
+    return;
+  }
+  if (std::find(retained_.begin(), retained_.end(), group) != retained_.end()) {
+    return;
+  }
+  retained_.reserve(retained_.size() + 1);
+  // Groups that the new one already holds need not be kept on their own.
+  // Pools trading nodes back and forth thus end up sharing one group instead
+  // of nesting a new one on every exchange.
+  const auto& children = group->children_;
+  retained_.erase(std::remove_if(retained_.begin(), retained_.end(),
+                                 [&children](const group_ptr& retained) {
+                                   return std::find(children.begin(),
+                                                    children.end(),
+                                                    retained) !=
+                                          children.end();
+                                 }),
+                  retained_.end());
+  retained_.push_back(std::move(group));
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::group_ptr
+NodePool<NodeType, Allocator>::Share() {
+  if (slabs_.empty()) {
+    if (retained_.empty()) return nullptr;
+    if (retained_.size() == 1) return retained_.front();
+  }
+  // The cursor and the free list may keep pointing into the sealed slabs:
+  // this pool holds the group, so they stay valid. Everything that can
+  // throw comes first, so a failure leaves the pool as it was.
+  std::vector<group_ptr, group_ptr_allocator> sealed{
+      group_ptr_allocator(alloc_)};
+  sealed.reserve(1);
+  group_ptr group = std::allocate_shared<SlabGroup>(
+      group_allocator(alloc_), alloc_, std::move(slabs_),
+      std::move(retained_));
+  slabs_.clear();
+  retained_ = std::move(sealed);
+  retained_.push_back(group);
+  return group;
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::bin_ptr
+NodePool<NodeType, Allocator>::SharedBin() {
+  if (bin_ == nullptr) {
+    bin_ = std::allocate_shared<Bin>(bin_allocator(alloc_));
+  }
+  return bin_;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Recycle(const bin_ptr& bin,
+                                            allocator_type& alloc,
+                                            NodeType* node) noexcept {
+  slot_traits::destroy(alloc, node);
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->next_ = bin->head_.load(std::memory_order_relaxed);
+  while (!bin->head_.compare_exchange_weak(slot->next_, slot,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::SlabGroup::SlabGroup(
+    const slot_allocator& alloc, std::vector<Slab, slab_allocator>&& slabs,
+    std::vector<group_ptr, group_ptr_allocator>&& children)
+    : alloc_(alloc),
+      slabs_(std::move(slabs)),
+      children_(std::move(children)),
+      slots_(0) {
+  for (const Slab& slab : slabs_) {
+    slots_ += slab.count_;
+  }
+  for (const group_ptr& child : children_) {
+    slots_ += child->slots_;
+  }
+}
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::SlabGroup::~SlabGroup() {
+  for (const Slab& slab : slabs_) {
+    slot_traits::deallocate(alloc_, slab.slots_, slab.count_);
+  }
+}
+
+template <typename NodeType, typename Allocator>
+typename NodePool<NodeType, Allocator>::Slot*
+NodePool<NodeType, Allocator>::Allocate() {
+  if (free_ == nullptr && cursor_ == slab_end_) {
+    Reclaim();
+  }
+  if (free_ != nullptr) {
+    Slot* slot = free_;
+    free_ = free_->next_;
+    --free_count_;
+    return slot;
+  }
+  if (cursor_ == slab_end_) {
+    AddSlab(next_slab_size_);
+    if (next_slab_size_ < kMaxSlabSize) {
+      next_slab_size_ *= 2;
+    }
+  }
+  return cursor_++;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::AddSlab(size_type count) {
+  // Made room for first, so the slab cannot leak when push_back throws.
+  if (slabs_.size() == slabs_.capacity()) {
+    slabs_.reserve(2 * slabs_.size() + 1);
+  }
+  Slot* slab = slot_traits::allocate(alloc_, count);
+  slabs_.push_back(Slab{slab, count});
+  // The unused tail of the current slab is not lost: it goes to the free list.
+  while (cursor_ != slab_end_) {
+    Slot* slot = cursor_++;
+    slot->next_ = free_;
+    free_ = slot;
+    ++free_count_;
+  }
+  cursor_ = slab;
+  slab_end_ = slab + count;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Reclaim() noexcept {
+  if (bin_ == nullptr) {
+    return;
+  }
+  // The whole list is taken at once, so handles may keep pushing meanwhile.
+  Slot* slot = bin_->head_.exchange(nullptr, std::memory_order_acquire);
+  while (slot != nullptr) {
+    Slot* next = slot->next_;
+    slot->next_ = free_;
+    free_ = slot;
+    ++free_count_;
+    slot = next;
+  }
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::Release() noexcept {
+  for (const Slab& slab : slabs_) {
+    slot_traits::deallocate(alloc_, slab.slots_, slab.count_);
+  }
+  slabs_.clear();
+  retained_.clear();
+  // Slots still in the bin point into the memory just released.
+  bin_.reset();
+  free_ = nullptr;
+  cursor_ = nullptr;
+  slab_end_ = nullptr;
+  free_count_ = 0;
+  next_slab_size_ = kFirstSlabSize;
+}
+
+}  // namespace s21
@@ -0,0 +1,71 @@
+#ifndef SRC_S21_CONTAINERS_GENERAL_STRUCTURES_RECLAIMER_H_
+#define SRC_S21_CONTAINERS_GENERAL_STRUCTURES_RECLAIMER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Destroys retired containers on a background thread, so dropping a large
+// Map, Set or List costs the caller one move and one allocation instead of
+// a walk over every element.
+//
+// At most max_backlog containers wait at a time. Past that, Retire destroys
+// the container on the calling thread rather than block or grow, which also
+// makes a zero backlog mean "never defer". Flush waits until every retired
+// container is gone, and the destructor flushes before stopping the thread.
+class Reclaimer {
+ public:
+  static constexpr std::size_t kDefaultBacklog = 64;
+
+  explicit Reclaimer(std::size_t max_backlog = kDefaultBacklog);
+  Reclaimer(const Reclaimer& other) = delete;
+  ~Reclaimer();
+
+  Reclaimer& operator=(const Reclaimer& other) = delete;
+
+  // The process-wide reclaimer used by DeferredDelete. Its thread starts on
+  // first use and is flushed and joined at exit.
+  static Reclaimer& Instance();
+
+  // Takes over container, leaving it moved-from, and destroys it later.
+  template <typename C>
+  void Retire(C&& container);
+  void Flush();
+  // Retired containers not yet destroyed, including one being destroyed.
+  std::size_t Backlog() const;
+
+ private:
+  struct Job {
+    void* object_;
+    void (*destroy_)(void*);
+  };
+
+  void Run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable has_work_;
+  std::condition_variable idle_;
+  // Ring buffer of waiting jobs.
+  std::vector<Job> jobs_;
+  std::size_t head_;
+  std::size_t waiting_;
+  bool busy_;
+  bool stopping_;
+  std::thread worker_;
+};
+
+// Hands container to Reclaimer::Instance(), as in
+// s21::DeferredDelete(std::move(map)). Returns in O(1).
+template <typename C>
+void DeferredDelete(C&& container);
+
+}  // namespace s21
+
+#include "reclaimer.tpp"
+#endif  // SRC_S21_CONTAINERS_GENERAL_STRUCTURES_RECLAIMER_H_
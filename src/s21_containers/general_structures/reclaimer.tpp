@@ -0,0 +1,89 @@
+#include "reclaimer.h"
+
+namespace s21 {
+
+inline Reclaimer::Reclaimer(std::size_t max_backlog)
+    : jobs_(max_backlog),
+      head_(0),
+      waiting_(0),
+      busy_(false),
+      stopping_(false) {
+  if (max_backlog > 0) {
+    worker_ = std::thread(&Reclaimer::Run, this);
+  }
+}
+
+inline Reclaimer::~Reclaimer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  has_work_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+inline Reclaimer& Reclaimer::Instance() {
+  static Reclaimer instance;
+  return instance;
+}
+
+template <typename C>
+void Reclaimer::Retire(C&& container) {
+  static_assert(!std::is_lvalue_reference_v<C>,
+                "Retire takes ownership; pass std::move(container)");
+  using Owned = std::remove_cv_t<C>;
+  Job job{new Owned(std::move(container)),
+          [](void* object) { delete static_cast<Owned*>(object); }};
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopping_ || waiting_ == jobs_.size()) {
+    lock.unlock();
+    job.destroy_(job.object_);
+    return;
+  }
+  jobs_[(head_ + waiting_) % jobs_.size()] = job;
+  ++waiting_;
+  lock.unlock();
+  has_work_.notify_one();
+}
+
+inline void Reclaimer::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return waiting_ == 0 && !busy_; });
+}
+
+inline std::size_t Reclaimer::Backlog() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return waiting_ + (busy_ ? 1 : 0);
+}
+
+inline void Reclaimer::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    has_work_.wait(lock, [this] { return waiting_ > 0 || stopping_; });
+    // Whatever is still waiting when the reclaimer stops is destroyed
+    // before the thread exits.
+    if (waiting_ == 0) {
+      return;
+    }
+    Job job = jobs_[head_];
+    head_ = (head_ + 1) % jobs_.size();
+    --waiting_;
+    busy_ = true;
+    lock.unlock();
+    job.destroy_(job.object_);
+    lock.lock();
+    busy_ = false;
+    if (waiting_ == 0) {
+      idle_.notify_all();
+    }
+  }
+}
+
+template <typename C>
+void DeferredDelete(C&& container) {
+  Reclaimer::Instance().Retire(std::forward<C>(container));
+}
+
+}  // namespace s21
@@ -3,15 +3,17 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 
 #include "list_iterators.h"
 #include "list_node.h"
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class List {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
   using iterator = ListIterator<T>;
@@ -20,8 +22,10 @@ class List {
   using node_type = node<T>;
 
   List() noexcept;
-  List(size_type n);
-  List(std::initializer_list<value_type> const& items) noexcept;
+  explicit List(const Allocator& alloc) noexcept;
+  List(size_type n, const Allocator& alloc = Allocator());
+  List(std::initializer_list<value_type> const& items,
+       const Allocator& alloc = Allocator()) noexcept;
   List(const List& l) noexcept;
   List(List&& l) noexcept;
   ~List() noexcept;
@@ -52,12 +56,29 @@ class List {
   void Unique() noexcept;
   void Sort() noexcept;
 
+  allocator_type GetAllocator() const noexcept;
+
  private:
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<
+          node_type>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   node_type* root_;
   node_type* end_;
   size_type size_list_;
-  node_type* fake_ = nullptr;
-  void FakeEndElement() noexcept;
+  // End() node, held in place so that an empty list owns no memory and T
+  // need not be default constructible. It sits in a union because it is
+  // never destroyed.
+  union {
+    node_type fake_;
+  };
+  node_allocator node_alloc_;
+  // Points fake_ and the first and last nodes at each other, after the
+  // nodes changed hands.
+  void LinkFake() noexcept;
+  node_type* CreateNode(const_reference value);
+  void DestroyNode(node_type* node) noexcept;
 };
 }  // namespace s21
 #include "list.tpp"
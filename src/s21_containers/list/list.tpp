@@ -1,81 +1,113 @@
 namespace s21 {
-template <typename T>
-List<T>::List() noexcept : root_(nullptr), end_(nullptr), size_list_(0) {
-  FakeEndElement();
-}
-
-template <typename T>
-void List<T>::FakeEndElement() noexcept {
-  fake_ = new node_type(T());
-  fake_->next_ = nullptr;
-  fake_->prev_ = nullptr;
-}
-
-template <typename T>
-List<T>::List(size_type n) : root_(nullptr), end_(nullptr), size_list_(0) {
+template <typename T, typename Allocator>
+List<T, Allocator>::List() noexcept : List(Allocator()) {}
+
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const Allocator& alloc) noexcept
+    : root_(nullptr),
+      end_(nullptr),
+      size_list_(0),
+      fake_(),
+      node_alloc_(alloc) {}
+
+template <typename T, typename Allocator>
+List<T, Allocator>::List(size_type n, const Allocator& alloc)
+    : root_(nullptr),
+      end_(nullptr),
+      size_list_(0),
+      fake_(),
+      node_alloc_(alloc) {
   if (n == 0) {
     throw std::out_of_range("Index out of range");
   }
-  FakeEndElement();
   for (size_type i = 0; i < n; ++i) {
     PushBack(T());
   }
 }
 
-template <typename T>
-List<T>::List(std::initializer_list<value_type> const& items) noexcept
-    : root_(nullptr), end_(nullptr), size_list_(0) {
-  FakeEndElement();
+template <typename T, typename Allocator>
+List<T, Allocator>::List(std::initializer_list<value_type> const& items,
+                         const Allocator& alloc) noexcept
+    : root_(nullptr),
+      end_(nullptr),
+      size_list_(0),
+      fake_(),
+      node_alloc_(alloc) {
   for (const_reference item : items) {
     PushBack(item);
   }
 }
 
-template <typename T>
-List<T>::List(const List& l) noexcept
-    : root_(nullptr), end_(nullptr), size_list_(0) {
-  FakeEndElement();
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const List& l) noexcept
+    : root_(nullptr),
+      end_(nullptr),
+      size_list_(0),
+      fake_(),
+      node_alloc_(
+          node_traits::select_on_container_copy_construction(l.node_alloc_)) {
   *this = l;
 }
 
-template <typename T>
-List<T>::List(List&& l) noexcept
-    : root_(l.root_), end_(l.end_), size_list_(l.size_list_), fake_(l.fake_) {
+template <typename T, typename Allocator>
+List<T, Allocator>::List(List&& l) noexcept
+    : root_(l.root_),
+      end_(l.end_),
+      size_list_(l.size_list_),
+      fake_(),
+      node_alloc_(std::move(l.node_alloc_)) {
+  LinkFake();
   l.root_ = nullptr;
   l.end_ = nullptr;
-  l.fake_ = nullptr;
   l.size_list_ = 0;
+  l.LinkFake();
 }
 
-template <typename T>
-List<T>::~List() noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::~List() noexcept {
   Clear();
-  if (fake_ != nullptr) {
-    delete fake_;
-  }
-  fake_ = nullptr;
 }
 
-template <typename T>
-List<T>& List<T>::operator=(List<T>&& l) noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(
+    List<T, Allocator>&& l) noexcept {
   if (this != &l) {
-    List<T> Tmp_lst(std::move(l));
-    *this = Tmp_lst;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        node_alloc_ == l.node_alloc_) {
+      Clear();
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        node_alloc_ = std::move(l.node_alloc_);
+      }
+      root_ = l.root_;
+      end_ = l.end_;
+      size_list_ = l.size_list_;
+      LinkFake();
+      l.root_ = nullptr;
+      l.end_ = nullptr;
+      l.size_list_ = 0;
+      l.LinkFake();
+    } else {
+      *this = static_cast<const List&>(l);
+      l.Clear();
+    }
   }
   return *this;
 }
 
-template <typename T>
-List<T>& List<T>::operator=(const List<T>& other) noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(
+    const List<T, Allocator>& other) noexcept {
   if (this != &other) {
     Clear();
 
-    if (!fake_) {
-      FakeEndElement();
+    if constexpr (node_traits::propagate_on_container_copy_assignment::
+                      value) {
+      node_alloc_ = other.node_alloc_;
     }
 
     node_type* tmp_node = other.root_;
-    while (tmp_node != other.fake_) {
+    while (tmp_node != &other.fake_) {
       PushBack(tmp_node->value_);
       tmp_node = tmp_node->next_;
     }
@@ -83,73 +115,77 @@ List<T>& List<T>::operator=(const List<T>& other) noexcept {
   return *this;
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::Front() const {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::const_reference List<T, Allocator>::Front() const {
   if (Empty()) {
     throw std::out_of_range("List is Empty");
   }
   return root_->value_;
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::Back() const {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::const_reference List<T, Allocator>::Back() const {
   if (Empty()) {
     throw std::out_of_range("List is Empty");
   }
   return end_->value_;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::Begin() const noexcept {
-  return iterator(root_ ? root_ : fake_);
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::Begin()
+    const noexcept {
+  return root_ ? iterator(root_) : End();
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::End() const noexcept {
-  return iterator(fake_);
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::End() const noexcept {
+  // Only the links of fake_ ever change, so it is never truly const.
+  return iterator(const_cast<node_type*>(&fake_));
 }
 
-template <typename T>
-bool List<T>::Empty() const noexcept {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::Empty() const noexcept {
   return size_list_ == 0;
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::Size() const noexcept {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::size_type List<T, Allocator>::Size()
+    const noexcept {
   return size_list_;
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::MaxSize() const noexcept {
+template <typename T, typename Allocator>
+typename List<T, Allocator>::size_type List<T, Allocator>::MaxSize()
+    const noexcept {
   return std::numeric_limits<size_t>::max() / sizeof(node_type) / 2;
 }
 
-template <typename T>
-void List<T>::Clear() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Clear() noexcept {
   while (size_list_ != 0) {
     PopFront();
   }
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::Insert(iterator pos,
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::Insert(iterator pos,
                                            const_reference value) noexcept {
-  node_type* new_node_ = new node_type{value, nullptr, nullptr};
+  node_type* new_node_ = CreateNode(value);
   node_type* pos_node_ = pos.GetNodePointer();
   if (size_list_ == 0) {
     root_ = new_node_;
     end_ = new_node_;
-    end_->next_ = fake_;
-    root_->prev_ = fake_;
+    end_->next_ = &fake_;
+    root_->prev_ = &fake_;
   } else if (pos_node_ == root_) {
     new_node_->next_ = root_;
     root_->prev_ = new_node_;
     root_ = new_node_;
-  } else if (pos_node_ == fake_) {
+  } else if (pos_node_ == &fake_) {
     new_node_->prev_ = end_;
     end_->next_ = new_node_;
     end_ = new_node_;
-    end_->next_ = fake_;
+    end_->next_ = &fake_;
   } else {
     node_type* prev_node = pos_node_->prev_;
     new_node_->prev_ = prev_node;
@@ -159,16 +195,16 @@ typename List<T>::iterator List<T>::Insert(iterator pos,
   }
 
   ++size_list_;
-  fake_->prev_ = end_;
-  fake_->next_ = root_;
+  fake_.prev_ = end_;
+  fake_.next_ = root_;
 
   return iterator(new_node_);
 }
 
-template <typename T>
-void List<T>::Erase(iterator pos) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Erase(iterator pos) noexcept {
   node_type* pos_node_ = pos.GetNodePointer();
-  if (pos_node_ != fake_) {
+  if (pos_node_ != &fake_) {
     if (pos_node_ == root_) {
       PopFront();
     } else if (pos_node_ == end_) {
@@ -179,39 +215,39 @@ void List<T>::Erase(iterator pos) noexcept {
       prev->next_ = next;
       next->prev_ = prev;
       --size_list_;
-      delete pos_node_;
+      DestroyNode(pos_node_);
     }
   };
 }
 
-template <typename T>
-void List<T>::PushBack(const_reference value) noexcept {
-  node_type* new_node = new node_type{value, nullptr, nullptr};
+template <typename T, typename Allocator>
+void List<T, Allocator>::PushBack(const_reference value) noexcept {
+  node_type* new_node = CreateNode(value);
   if (!root_) {
     root_ = new_node;
-    root_->next_ = fake_;
-    root_->prev_ = fake_;
-    fake_->prev_ = root_;
-    fake_->next_ = root_;
+    root_->next_ = &fake_;
+    root_->prev_ = &fake_;
+    fake_.prev_ = root_;
+    fake_.next_ = root_;
   } else if (!end_) {
     end_ = new_node;
-    end_->next_ = fake_;
+    end_->next_ = &fake_;
     end_->prev_ = root_;
-    fake_->prev_ = end_;
-    fake_->next_ = root_;
+    fake_.prev_ = end_;
+    fake_.next_ = root_;
     root_->next_ = end_;
   } else {
     new_node->prev_ = end_;
     end_->next_ = new_node;
     end_ = new_node;
-    end_->next_ = fake_;
-    fake_->prev_ = end_;
+    end_->next_ = &fake_;
+    fake_.prev_ = end_;
   }
   ++size_list_;
 }
 
-template <typename T>
-void List<T>::PopBack() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::PopBack() noexcept {
   if (end_) {
     if (end_ == root_) {
       root_ = nullptr;
@@ -219,46 +255,46 @@ void List<T>::PopBack() noexcept {
       size_list_ = 0;
     } else {
       end_->next_->prev_ = end_->prev_;
-      end_->prev_->next_ = fake_;
+      end_->prev_->next_ = &fake_;
       node_type* rm_elem = end_;
       end_ = end_->prev_;
-      delete rm_elem;
+      DestroyNode(rm_elem);
       --size_list_;
     }
   }
 }
 
-template <typename T>
-void List<T>::PushFront(const_reference value) noexcept {
-  node_type* new_node = new node_type{value, nullptr, nullptr};
+template <typename T, typename Allocator>
+void List<T, Allocator>::PushFront(const_reference value) noexcept {
+  node_type* new_node = CreateNode(value);
   if (!root_) {
     root_ = new_node;
-    root_->prev_ = fake_;
-    root_->next_ = fake_;
-    fake_->next_ = root_;
-    fake_->prev_ = root_;
+    root_->prev_ = &fake_;
+    root_->next_ = &fake_;
+    fake_.next_ = root_;
+    fake_.prev_ = root_;
   } else if (!end_) {
     end_ = root_;
-    end_->next_ = fake_;
+    end_->next_ = &fake_;
     end_->prev_ = new_node;
-    fake_->prev_ = end_;
-    fake_->next_ = new_node;
+    fake_.prev_ = end_;
+    fake_.next_ = new_node;
     new_node->next_ = end_;
     root_ = new_node;
   } else {
     new_node->next_ = root_;
     root_ = new_node;
-    fake_->next_ = root_;
-    root_->prev_ = fake_;
+    fake_.next_ = root_;
+    root_->prev_ = &fake_;
   }
   ++size_list_;
 }
 
-template <typename T>
-void List<T>::PopFront() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::PopFront() noexcept {
   if (root_) {
     node_type* rm_elem = root_;
-    if (root_->next_ != fake_) {
+    if (root_->next_ != &fake_) {
       root_ = root_->next_;
     } else {
       root_ = nullptr;
@@ -266,45 +302,47 @@ void List<T>::PopFront() noexcept {
     }
 
     if (rm_elem->next_) {
-      rm_elem->next_->prev_ = fake_;
-      delete rm_elem;
+      rm_elem->next_->prev_ = &fake_;
+      DestroyNode(rm_elem);
     }
 
     if (size_list_ == 2) {
       root_ = end_;
-      fake_->next_ = root_;
-      fake_->prev_ = root_;
-      root_->next_ = fake_;
-      root_->prev_ = fake_;
+      fake_.next_ = root_;
+      fake_.prev_ = root_;
+      root_->next_ = &fake_;
+      root_->prev_ = &fake_;
       end_ = nullptr;
     }
     --size_list_;
   }
 }
 
-template <typename T>
-void List<T>::Swap(List& other) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Swap(List& other) noexcept {
   node_type* swap_root_ = root_;
   node_type* swap_end_ = end_;
-  node_type* swap_fake_ = fake_;
   size_type swap_size_ = size_list_;
   root_ = other.root_;
   end_ = other.end_;
-  fake_ = other.fake_;
   size_list_ = other.size_list_;
   other.root_ = swap_root_;
   other.end_ = swap_end_;
-  other.fake_ = swap_fake_;
   other.size_list_ = swap_size_;
+  LinkFake();
+  other.LinkFake();
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(node_alloc_, other.node_alloc_);
+  }
 }
 
-template <typename T>
-void List<T>::Merge(List& other) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Merge(List& other) noexcept {
   if (this == &other) {
     return;
   }
 
-  List<value_type> merged_list;
+  List merged_list(GetAllocator());
 
   while (!Empty() && !other.Empty()) {
     if (Front() <= other.Front()) {
@@ -326,9 +364,9 @@ void List<T>::Merge(List& other) noexcept {
   Swap(merged_list);
 }
 
-template <typename T>
-void List<T>::Splice(const_iterator pos, List& other) noexcept {
-  List<T>::iterator pos_ = pos;
+template <typename T, typename Allocator>
+void List<T, Allocator>::Splice(const_iterator pos, List& other) noexcept {
+  List<T, Allocator>::iterator pos_ = pos;
   node_type* pos_node_ = pos_.GetNodePointer();
   if (!other.Empty() && pos_node_ != nullptr) {
     if (pos_node_ == root_) {
@@ -346,22 +384,20 @@ void List<T>::Splice(const_iterator pos, List& other) noexcept {
       pos_node_->prev_ = other.end_;
     }
     size_list_ += other.size_list_;
+    LinkFake();
   }
   other.root_ = nullptr;
   other.end_ = nullptr;
-  if (other.fake_ != nullptr) {
-    delete other.fake_;
-  }
-  other.fake_ = nullptr;
   other.size_list_ = 0;
+  other.LinkFake();
 }
 
-template <typename T>
-void List<T>::Reverse() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Reverse() noexcept {
   if (size_list_ > 1) {
     node_type* current_ = end_;
     node_type* tmp_ = nullptr;
-    while (current_ != fake_) {
+    while (current_ != &fake_) {
       current_->next_ = current_->prev_;
       current_->prev_->next_ = current_;
       current_ = current_->prev_;
@@ -373,35 +409,35 @@ void List<T>::Reverse() noexcept {
   }
 }
 
-template <typename T>
-void List<T>::Unique() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Unique() noexcept {
   if (size_list_ > 1) {
     node_type* current_ = root_;
     node_type* next_node_ = nullptr;
 
-    while (current_->next_ != fake_) {
+    while (current_->next_ != &fake_) {
       next_node_ = current_->next_;
       if (current_->value_ == next_node_->value_) {
         current_->next_ = next_node_->next_;
         next_node_->next_->prev_ = current_;
         --size_list_;
         if (next_node_ != nullptr) {
-          delete next_node_;
+          DestroyNode(next_node_);
           next_node_ = nullptr;
         }
       } else {
         current_ = current_->next_;
       }
     }
-    end_ = fake_->prev_;
+    end_ = fake_.prev_;
   }
 }
 
-template <typename T>
-void List<T>::Sort() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::Sort() noexcept {
   if (size_list_ > 1) {
-    for (node_type* it_i = root_; it_i != fake_; it_i = it_i->next_) {
-      for (node_type* it_j = root_; it_j != fake_; it_j = it_j->next_) {
+    for (node_type* it_i = root_; it_i != &fake_; it_i = it_i->next_) {
+      for (node_type* it_j = root_; it_j != &fake_; it_j = it_j->next_) {
         value_type tmp_;
         if (it_j->value_ > it_i->value_) {
           tmp_ = it_j->value_;
@@ -412,4 +448,42 @@ void List<T>::Sort() noexcept {
     }
   }
 }
+
+template <typename T, typename Allocator>
+typename List<T, Allocator>::allocator_type List<T, Allocator>::GetAllocator()
+    const noexcept {
+  return allocator_type(node_alloc_);
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::LinkFake() noexcept {
+  node_type* last = end_ ? end_ : root_;
+  fake_.next_ = root_;
+  fake_.prev_ = last;
+  if (root_) {
+    root_->prev_ = &fake_;
+    last->next_ = &fake_;
+  }
+}
+
+template <typename T, typename Allocator>
+typename List<T, Allocator>::node_type* List<T, Allocator>::CreateNode(
+    const_reference value) {
+  node_type* new_node = node_traits::allocate(node_alloc_, 1);
+  try {
+    node_traits::construct(node_alloc_, new_node, value);
+  } catch (...) {
+    node_traits::deallocate(node_alloc_, new_node, 1);
+    throw;
+  }
+  return new_node;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::DestroyNode(node_type* node) noexcept {
+  if (node != nullptr) {
+    node_traits::destroy(node_alloc_, node);
+    node_traits::deallocate(node_alloc_, node, 1);
+  }
+}
 }  // namespace s21
@@ -4,11 +4,17 @@
 namespace s21 {
 template <typename T>
 struct node {
-  T value_;
+  // In a union so that the sentinel of a List can go without a value.
+  union {
+    T value_;
+  };
   node* next_;
   node* prev_;
+  // Builds the sentinel of a List: no value, and never destroyed.
+  node() noexcept : next_(nullptr), prev_(nullptr) {}
   node(const T& value, node* next = nullptr, node* prev = nullptr)
       : value_(value), next_(next), prev_(prev) {}
+  ~node() { value_.~T(); }
 };
 }  // namespace s21
 #endif  // SRC_S21_CONTAINERS_LIST_LIST_NODE_H_
@@ -5,67 +5,197 @@
 
 namespace s21 {
 
-template <typename Key, typename T>
-class Map : public Container<Key, T> {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Augment = NoAugment>
+class Map : public Container<Key, T, Compare, Allocator, Augment> {
  public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename Container<Key, T>::iterator;
-  using const_iterator = typename Container<Key, T>::const_iterator;
-  using size_type = typename Container<Key, T>::size_type;
-
-  Map() noexcept : Container<Key, T>() {}
-  Map(std::initializer_list<value_type> const& items)
-      : Container<Key, T>(items) {}
-  Map(const Map& m) noexcept = default;
+  using iterator =
+      typename Container<Key, T, Compare, Allocator, Augment>::iterator;
+  using const_iterator =
+      typename Container<Key, T, Compare, Allocator, Augment>::const_iterator;
+  using size_type =
+      typename Container<Key, T, Compare, Allocator, Augment>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type =
+      typename Container<Key, T, Compare, Allocator, Augment>::node_type;
+
+  Map() noexcept : Container<Key, T, Compare, Allocator, Augment>() {}
+  explicit Map(const Allocator& alloc) noexcept
+      : Container<Key, T, Compare, Allocator, Augment>(alloc) {}
+  explicit Map(const Compare& comp,
+               const Allocator& alloc = Allocator()) noexcept
+      : Container<Key, T, Compare, Allocator, Augment>(comp, alloc) {}
+  Map(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : Container<Key, T, Compare, Allocator, Augment>(items, comp, alloc) {}
+  Map(std::initializer_list<value_type> const& items, const Allocator& alloc)
+      : Container<Key, T, Compare, Allocator, Augment>(items, alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Map(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : Container<Key, T, Compare, Allocator, Augment>(first, last, comp,
+                                                        alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Map(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : Container<Key, T, Compare, Allocator, Augment>(first, last, alloc) {}
+  Map(const Map& m) = default;
   Map(Map&& m) noexcept = default;
   ~Map() = default;
-  Map<Key, T>& operator=(Map&& m) noexcept = default;
-  Map<Key, T>& operator=(const Map& m) noexcept = default;
+  Map& operator=(Map&& m) noexcept = default;
+  Map& operator=(const Map& m) = default;
 
   std::pair<iterator, bool> Insert(const value_type& value) {
-    return Container<Key, T>::Insert(value);
+    return Container<Key, T, Compare, Allocator, Augment>::Insert(value);
+  }
+
+  std::pair<iterator, bool> Insert(value_type&& value) {
+    return EmplaceUnique(nullptr, value.first, std::piecewise_construct,
+                         std::forward_as_tuple(value.first),
+                         std::forward_as_tuple(std::move(value.second)));
   }
 
   std::pair<iterator, bool> Insert(const Key& key, const T& obj) {
-    value_type value(key, obj);
-    return Insert(value);
+    return TryEmplace(key, obj);
+  }
+
+  iterator Insert(iterator hint, const value_type& value) {
+    return Container<Key, T, Compare, Allocator, Augment>::Insert(hint, value);
+  }
+
+  iterator Insert(iterator hint, value_type&& value) {
+    return EmplaceUnique(hint.getCurrent(), value.first,
+                         std::piecewise_construct,
+                         std::forward_as_tuple(value.first),
+                         std::forward_as_tuple(std::move(value.second)))
+        .first;
+  }
+
+  std::pair<iterator, bool> Insert(node_type&& node) {
+    return Container<Key, T, Compare, Allocator, Augment>::Insert(
+        std::move(node));
+  }
+
+  iterator Insert(iterator hint, node_type&& node) {
+    return Container<Key, T, Compare, Allocator, Augment>::Insert(
+        hint, std::move(node));
+  }
+
+  // Constructs the element inside its node from (key, obj), a pair, or a
+  // piecewise_construct pair of tuples. When the key is given as a Key it
+  // is looked up first and nothing is built if it is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args&&... args) {
+    return EmplaceAt(nullptr, std::forward<Args>(args)...);
+  }
+
+  // Emplace that uses hint the same way as Insert(hint, value).
+  template <typename... Args>
+  iterator EmplaceHint(iterator hint, Args&&... args) {
+    return EmplaceAt(hint.getCurrent(), std::forward<Args>(args)...).first;
+  }
+
+  // Inserts a value built from args only if key is missing; otherwise args
+  // are left untouched.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+    return EmplaceUnique(nullptr, key, std::piecewise_construct,
+                         std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+    return EmplaceUnique(nullptr, key, std::piecewise_construct,
+                         std::forward_as_tuple(std::move(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Unlike insert_or_assign, second tells whether a new element was
+  // inserted, as in std::map.
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(const Key& key, M&& obj) {
+    auto result = TryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first.getCurrent()->val_ = std::forward<M>(obj);
+      UpdatePath(result.first.getCurrent());
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(Key&& key, M&& obj) {
+    auto result = TryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first.getCurrent()->val_ = std::forward<M>(obj);
+      UpdatePath(result.first.getCurrent());
+    }
+    return result;
   }
 
+  // second is also true when an existing element got a different value.
+  // A hit always assigns; the comparison only decides second.
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
-    value_type value(key, obj);
-    auto result = Insert(value);
+    auto result = TryEmplace(key, obj);
     if (!result.second) {
-      if (result.first.getCurrent()->val_ != obj) {
-        result.first.getCurrent()->val_ = obj;
-        result.second = true;
-      }
+      Node<Key, T, Augment>* node = result.first.getCurrent();
+      result.second = node->val_ != obj;
+      node->val_ = obj;
+      UpdatePath(node);
     }
     return result;
   }
 
-  using Container<Key, T>::Begin;
-  using Container<Key, T>::End;
-  using Container<Key, T>::CBegin;
-  using Container<Key, T>::CEnd;
+  using Container<Key, T, Compare, Allocator, Augment>::BuildFromSorted;
 
-  using Container<Key, T>::Merge;
-  using Container<Key, T>::Clear;
+  using Container<Key, T, Compare, Allocator, Augment>::Begin;
+  using Container<Key, T, Compare, Allocator, Augment>::End;
+  using Container<Key, T, Compare, Allocator, Augment>::CBegin;
+  using Container<Key, T, Compare, Allocator, Augment>::CEnd;
 
-  using Container<Key, T>::Swap;
-  using Container<Key, T>::Erase;
+  using Container<Key, T, Compare, Allocator, Augment>::Merge;
+  using Container<Key, T, Compare, Allocator, Augment>::Split;
+  using Container<Key, T, Compare, Allocator, Augment>::Join;
+  using Container<Key, T, Compare, Allocator, Augment>::Union;
+  using Container<Key, T, Compare, Allocator, Augment>::Intersection;
+  using Container<Key, T, Compare, Allocator, Augment>::Difference;
+  using Container<Key, T, Compare, Allocator, Augment>::Clear;
 
-  using Container<Key, T>::Find;
-  using Container<Key, T>::Contains;
+  using Container<Key, T, Compare, Allocator, Augment>::Swap;
+  using Container<Key, T, Compare, Allocator, Augment>::Erase;
+  using Container<Key, T, Compare, Allocator, Augment>::Extract;
 
-  using Container<Key, T>::Empty;
-  using Container<Key, T>::Size;
-  using Container<Key, T>::MaxSize;
+  using Container<Key, T, Compare, Allocator, Augment>::Find;
+  using Container<Key, T, Compare, Allocator, Augment>::Contains;
+  using Container<Key, T, Compare, Allocator, Augment>::Count;
+  using Container<Key, T, Compare, Allocator, Augment>::LowerBound;
+  using Container<Key, T, Compare, Allocator, Augment>::UpperBound;
+  using Container<Key, T, Compare, Allocator, Augment>::EqualRange;
 
-  using Container<Key, T>::GetRoot;
+  using Container<Key, T, Compare, Allocator, Augment>::Empty;
+  using Container<Key, T, Compare, Allocator, Augment>::Size;
+  using Container<Key, T, Compare, Allocator, Augment>::MaxSize;
+  using Container<Key, T, Compare, Allocator, Augment>::Reserve;
+  using Container<Key, T, Compare, Allocator, Augment>::GetAllocator;
+  using Container<Key, T, Compare, Allocator, Augment>::KeyComp;
+
+  using Container<Key, T, Compare, Allocator, Augment>::Rank;
+  using Container<Key, T, Compare, Allocator, Augment>::Select;
+  using Container<Key, T, Compare, Allocator, Augment>::Advance;
+  using Container<Key, T, Compare, Allocator, Augment>::Aggregate;
+  using Container<Key, T, Compare, Allocator, Augment>::Refresh;
+
+  using Container<Key, T, Compare, Allocator, Augment>::GetRoot;
 
   T& At(const Key& key) {
     iterator it = Find(key);
@@ -74,20 +204,57 @@ class Map : public Container<Key, T> {
     }
     return it.getCurrent()->val_;
   }
-  T& operator[](const Key& key) {
-    iterator iter = Find(key);
-    if (iter == End()) {
-      value_type value(key, T());
-      auto res = Insert(value);
-      iter = res.first;
+  const T& At(const Key& key) const {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in Map");
     }
-    return iter.getCurrent()->val_;
+    return it.getCurrent()->val_;
+  }
+  T& operator[](const Key& key) {
+    return TryEmplace(key).first.getCurrent()->val_;
+  }
+  T& operator[](Key&& key) {
+    return TryEmplace(std::move(key)).first.getCurrent()->val_;
   }
 
  private:
-  using Container<Key, T>::root_;
-  using Container<Key, T>::dummy_;
-  using Container<Key, T>::size_cont_;
+  template <typename K, typename M>
+  std::pair<iterator, bool> EmplaceAt(Node<Key, T, Augment>* hint, K&& key,
+                                      M&& obj) {
+    if constexpr (std::is_same_v<std::decay_t<K>, Key>) {
+      return EmplaceUnique(hint, key, std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    } else {
+      return EmplaceNode(hint, std::piecewise_construct,
+                         std::forward_as_tuple(std::forward<K>(key)),
+                         std::forward_as_tuple(std::forward<M>(obj)));
+    }
+  }
+
+  template <typename P>
+  std::pair<iterator, bool> EmplaceAt(Node<Key, T, Augment>* hint, P&& value) {
+    return EmplaceAt(hint, std::get<0>(std::forward<P>(value)),
+                     std::get<1>(std::forward<P>(value)));
+  }
+
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> EmplaceAt(Node<Key, T, Augment>* hint,
+                                      std::piecewise_construct_t,
+                                      std::tuple<KeyArgs...> key_args,
+                                      std::tuple<ValArgs...> val_args) {
+    return EmplaceNode(hint, std::piecewise_construct, std::move(key_args),
+                       std::move(val_args));
+  }
+
+  using Container<Key, T, Compare, Allocator, Augment>::EmplaceNode;
+  using Container<Key, T, Compare, Allocator, Augment>::EmplaceUnique;
+  using Container<Key, T, Compare, Allocator, Augment>::UpdatePath;
+  using Container<Key, T, Compare, Allocator, Augment>::root_;
+  using Container<Key, T, Compare, Allocator, Augment>::leftmost_;
+  using Container<Key, T, Compare, Allocator, Augment>::dummy_;
+  using Container<Key, T, Compare, Allocator, Augment>::size_cont_;
 };
 
 }  // namespace s21
@@ -0,0 +1,174 @@
+#ifndef SRC_S21_CONTAINERS_MULTIMAP_MULTIMAP_H_
+#define SRC_S21_CONTAINERS_MULTIMAP_MULTIMAP_H_
+
+#include "../general_structures/container.h"
+
+namespace s21 {
+
+// Map that keeps equal keys, in the order they were inserted. Like
+// Multiset it leaves out node handles, Merge and the set algebra, and it
+// has no operator[] or At, as a key may name several values.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Augment = NoAugment>
+class Multimap : public Container<Key, T, Compare, Allocator, Augment> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename Container<Key, T, Compare, Allocator, Augment>::iterator;
+  using const_iterator =
+      typename Container<Key, T, Compare, Allocator, Augment>::const_iterator;
+  using size_type =
+      typename Container<Key, T, Compare, Allocator, Augment>::size_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  Multimap() noexcept = default;
+  explicit Multimap(const Allocator& alloc) noexcept
+      : Container<Key, T, Compare, Allocator, Augment>(alloc) {}
+  explicit Multimap(const Compare& comp,
+                    const Allocator& alloc = Allocator()) noexcept
+      : Container<Key, T, Compare, Allocator, Augment>(comp, alloc) {}
+  Multimap(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : Multimap(items.begin(), items.end(), comp, alloc) {}
+  Multimap(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : Multimap(items, Compare(), alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Multimap(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : Multimap(comp, alloc) {
+    for (; first != last; ++first) {
+      Append(*first);
+    }
+  }
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Multimap(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : Multimap(first, last, Compare(), alloc) {}
+  Multimap(const Multimap& m) = default;
+  Multimap(Multimap&& m) noexcept = default;
+  ~Multimap() = default;
+  Multimap& operator=(Multimap&& m) noexcept = default;
+  Multimap& operator=(const Multimap& m) = default;
+
+  iterator Insert(const value_type& value) {
+    return Emplace(value.first, value.second);
+  }
+
+  iterator Insert(value_type&& value) {
+    return Emplace(value.first, std::move(value.second));
+  }
+
+  iterator Insert(const Key& key, const T& obj) { return Emplace(key, obj); }
+
+  // Constructs the element inside its node from (key, obj).
+  template <typename K, typename M>
+  iterator Emplace(K&& key, M&& obj) {
+    return EmplaceEqual(nullptr, std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<M>(obj)));
+  }
+
+  template <typename... KeyArgs, typename... ValArgs>
+  iterator Emplace(std::piecewise_construct_t,
+                   std::tuple<KeyArgs...> key_args,
+                   std::tuple<ValArgs...> val_args) {
+    return EmplaceEqual(nullptr, std::piecewise_construct, std::move(key_args),
+                        std::move(val_args));
+  }
+
+  // Inserts each of values, which are pairs of key and value, in argument
+  // order, taking the memory for all of them at once. Values whose key is
+  // not less than the largest key so far, as in a sorted batch, are
+  // appended without a search.
+  template <typename... Args>
+  std::vector<iterator> InsertMany(Args&&... values) {
+    Reserve(Size() + sizeof...(Args));
+    return {Append(std::forward<Args>(values))...};
+  }
+
+  // Erases every element in [first, last), one at a time.
+  void Erase(iterator first, iterator last) {
+    while (first != last) {
+      iterator next = first;
+      ++next;
+      Erase(first);
+      first = next;
+    }
+  }
+
+  // O(log n + Count(key)).
+  size_type Count(const Key& key) const {
+    size_type count = 0;
+    for (auto range = EqualRange(key); range.first != range.second;
+         ++range.first) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Unlike Map::EqualRange this takes two descents, one for each bound.
+  std::pair<iterator, iterator> EqualRange(const Key& key) const {
+    Node<Key, T, Augment>* lower = this->LowerNode(key);
+    Node<Key, T, Augment>* upper = this->UpperNode(key);
+    return std::pair<iterator, iterator>(
+        lower != nullptr ? iterator(lower) : End(),
+        upper != nullptr ? iterator(upper) : End());
+  }
+
+  using Container<Key, T, Compare, Allocator, Augment>::Begin;
+  using Container<Key, T, Compare, Allocator, Augment>::End;
+  using Container<Key, T, Compare, Allocator, Augment>::CBegin;
+  using Container<Key, T, Compare, Allocator, Augment>::CEnd;
+
+  using Container<Key, T, Compare, Allocator, Augment>::Clear;
+  using Container<Key, T, Compare, Allocator, Augment>::Swap;
+  using Container<Key, T, Compare, Allocator, Augment>::Erase;
+
+  // Find returns the first of the elements equal to key.
+  using Container<Key, T, Compare, Allocator, Augment>::Find;
+  using Container<Key, T, Compare, Allocator, Augment>::Contains;
+  using Container<Key, T, Compare, Allocator, Augment>::LowerBound;
+  using Container<Key, T, Compare, Allocator, Augment>::UpperBound;
+
+  using Container<Key, T, Compare, Allocator, Augment>::Empty;
+  using Container<Key, T, Compare, Allocator, Augment>::Size;
+  using Container<Key, T, Compare, Allocator, Augment>::MaxSize;
+  using Container<Key, T, Compare, Allocator, Augment>::Reserve;
+  using Container<Key, T, Compare, Allocator, Augment>::GetAllocator;
+  using Container<Key, T, Compare, Allocator, Augment>::KeyComp;
+
+  using Container<Key, T, Compare, Allocator, Augment>::Rank;
+  using Container<Key, T, Compare, Allocator, Augment>::Select;
+  using Container<Key, T, Compare, Allocator, Augment>::Advance;
+  using Container<Key, T, Compare, Allocator, Augment>::Aggregate;
+  using Container<Key, T, Compare, Allocator, Augment>::Refresh;
+
+  using Container<Key, T, Compare, Allocator, Augment>::GetRoot;
+
+ private:
+  template <typename P>
+  iterator Append(P&& value) {
+    return EmplaceEqual(
+        &dummy_, std::piecewise_construct,
+        std::forward_as_tuple(std::get<0>(std::forward<P>(value))),
+        std::forward_as_tuple(std::get<1>(std::forward<P>(value))));
+  }
+
+  using Container<Key, T, Compare, Allocator, Augment>::EmplaceEqual;
+  using Container<Key, T, Compare, Allocator, Augment>::dummy_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_MULTIMAP_MULTIMAP_H_
@@ -0,0 +1,160 @@
+#ifndef SRC_S21_CONTAINERS_MULTISET_MULTISET_H_
+#define SRC_S21_CONTAINERS_MULTISET_MULTISET_H_
+
+#include "../general_structures/container.h"
+
+namespace s21 {
+
+// Set that keeps equal keys, in the order they were inserted. It shares the
+// tree of Set, but only offers operations that stay correct with duplicate
+// keys: node handles, Merge and the set algebra assume unique keys.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Augment = NoAugment>
+class Multiset : public Container<Key, void, Compare, Allocator, Augment> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename Container<Key, void, Compare, Allocator, Augment>::iterator;
+  using const_iterator = typename Container<Key, void, Compare, Allocator,
+                                            Augment>::const_iterator;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  Multiset() noexcept = default;
+  explicit Multiset(const Allocator& alloc) noexcept
+      : Container<Key, void, Compare, Allocator, Augment>(alloc) {}
+  explicit Multiset(const Compare& comp,
+                    const Allocator& alloc = Allocator()) noexcept
+      : Container<Key, void, Compare, Allocator, Augment>(comp, alloc) {}
+  Multiset(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : Multiset(items.begin(), items.end(), comp, alloc) {}
+  Multiset(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : Multiset(items, Compare(), alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Multiset(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : Multiset(comp, alloc) {
+    for (; first != last; ++first) {
+      Append(*first);
+    }
+  }
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Multiset(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : Multiset(first, last, Compare(), alloc) {}
+  Multiset(const Multiset& s) = default;
+  Multiset(Multiset&& other) noexcept = default;
+  ~Multiset() = default;
+  Multiset& operator=(Multiset&& other) noexcept = default;
+  Multiset& operator=(const Multiset& other) = default;
+
+  iterator Insert(const Key& key) {
+    return EmplaceEqual(nullptr, std::piecewise_construct,
+                        std::forward_as_tuple(key), std::tuple<>());
+  }
+
+  iterator Insert(Key&& key) {
+    return EmplaceEqual(nullptr, std::piecewise_construct,
+                        std::forward_as_tuple(std::move(key)),
+                        std::tuple<>());
+  }
+
+  // Constructs the key inside its node from args.
+  template <typename... Args>
+  iterator Emplace(Args&&... args) {
+    return EmplaceEqual(nullptr, std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<Args>(args)...),
+                        std::tuple<>());
+  }
+
+  // Inserts each of keys in argument order, taking the memory for all of
+  // them at once. Keys that are not less than the largest key so far, as
+  // in a sorted batch, are appended without a search.
+  template <typename... Args>
+  std::vector<iterator> InsertMany(Args&&... keys) {
+    Reserve(Size() + sizeof...(Args));
+    return {Append(std::forward<Args>(keys))...};
+  }
+
+  // Erases every element in [first, last), one at a time.
+  void Erase(iterator first, iterator last) {
+    while (first != last) {
+      iterator next = first;
+      ++next;
+      Erase(first);
+      first = next;
+    }
+  }
+
+  // O(log n + Count(key)).
+  size_type Count(const Key& key) const {
+    size_type count = 0;
+    for (auto range = EqualRange(key); range.first != range.second;
+         ++range.first) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Unlike Set::EqualRange this takes two descents, one for each bound.
+  std::pair<iterator, iterator> EqualRange(const Key& key) const {
+    Node<Key, void, Augment>* lower = this->LowerNode(key);
+    Node<Key, void, Augment>* upper = this->UpperNode(key);
+    return std::pair<iterator, iterator>(
+        lower != nullptr ? iterator(lower) : End(),
+        upper != nullptr ? iterator(upper) : End());
+  }
+
+  using Container<Key, void, Compare, Allocator, Augment>::Begin;
+  using Container<Key, void, Compare, Allocator, Augment>::End;
+  using Container<Key, void, Compare, Allocator, Augment>::CBegin;
+  using Container<Key, void, Compare, Allocator, Augment>::CEnd;
+
+  using Container<Key, void, Compare, Allocator, Augment>::Clear;
+  using Container<Key, void, Compare, Allocator, Augment>::Swap;
+  using Container<Key, void, Compare, Allocator, Augment>::Erase;
+
+  // Find returns the first of the elements equal to key.
+  using Container<Key, void, Compare, Allocator, Augment>::Find;
+  using Container<Key, void, Compare, Allocator, Augment>::Contains;
+  using Container<Key, void, Compare, Allocator, Augment>::LowerBound;
+  using Container<Key, void, Compare, Allocator, Augment>::UpperBound;
+
+  using Container<Key, void, Compare, Allocator, Augment>::Empty;
+  using Container<Key, void, Compare, Allocator, Augment>::Size;
+  using Container<Key, void, Compare, Allocator, Augment>::MaxSize;
+  using Container<Key, void, Compare, Allocator, Augment>::Reserve;
+  using Container<Key, void, Compare, Allocator, Augment>::GetAllocator;
+  using Container<Key, void, Compare, Allocator, Augment>::KeyComp;
+
+  using Container<Key, void, Compare, Allocator, Augment>::Rank;
+  using Container<Key, void, Compare, Allocator, Augment>::Select;
+  using Container<Key, void, Compare, Allocator, Augment>::Advance;
+
+  using Container<Key, void, Compare, Allocator, Augment>::GetRoot;
+
+ private:
+  template <typename K>
+  iterator Append(K&& key) {
+    return EmplaceEqual(&dummy_, std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::tuple<>());
+  }
+
+  using Container<Key, void, Compare, Allocator, Augment>::EmplaceEqual;
+  using Container<Key, void, Compare, Allocator, Augment>::dummy_;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_MULTISET_MULTISET_H_
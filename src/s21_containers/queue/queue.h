@@ -3,18 +3,22 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Queue {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
 
   Queue() noexcept;
-  Queue(std::initializer_list<value_type> const& items) noexcept;
+  explicit Queue(const Allocator& alloc) noexcept;
+  Queue(std::initializer_list<value_type> const& items,
+        const Allocator& alloc = Allocator()) noexcept;
   Queue(const Queue& q) noexcept;
   Queue(Queue&& q) noexcept;
   ~Queue() noexcept;
@@ -30,15 +34,26 @@ class Queue {
   void Pop() noexcept;
   void Swap(Queue& other) noexcept;
 
+  allocator_type GetAllocator() const noexcept;
+
  private:
   struct node {
     value_type value_;
     node* next_;
+    node(const value_type& value, node* next) : value_(value), next_(next) {}
   };
 
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  node* CreateNode(const_reference value);
+  void DestroyNode(node* old_node) noexcept;
+
   node* root_;
   node* end_;
   size_type size_queue_;
+  node_allocator node_alloc_;
 };
 }  // namespace s21
 #include "queue.tpp"
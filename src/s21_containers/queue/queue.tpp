@@ -1,18 +1,24 @@
 namespace s21 {
 
-template <typename T>
-Queue<T>::Queue() noexcept : root_(nullptr), end_(nullptr), size_queue_(0) {}
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue() noexcept : Queue(Allocator()) {}
 
-template <typename T>
-Queue<T>::Queue(std::initializer_list<value_type> const& items) noexcept
-    : Queue() {
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue(const Allocator& alloc) noexcept
+    : root_(nullptr), end_(nullptr), size_queue_(0), node_alloc_(alloc) {}
+
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue(std::initializer_list<value_type> const& items,
+                           const Allocator& alloc) noexcept
+    : Queue(alloc) {
   for (const auto& item : items) {
     Push(item);
   }
 }
 
-template <typename T>
-Queue<T>::Queue(const Queue& q) noexcept : Queue() {
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue(const Queue& q) noexcept
+    : Queue(node_traits::select_on_container_copy_construction(q.node_alloc_)) {
   node* current = q.root_;
   while (current) {
     Push(current->value_);
@@ -20,31 +26,50 @@ Queue<T>::Queue(const Queue& q) noexcept : Queue() {
   }
 }
 
-template <typename T>
-Queue<T>::Queue(Queue&& q) noexcept
-    : root_(q.root_), end_(q.end_), size_queue_(q.size_queue_) {
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue(Queue&& q) noexcept
+    : root_(q.root_),
+      end_(q.end_),
+      size_queue_(q.size_queue_),
+      node_alloc_(std::move(q.node_alloc_)) {
   q.root_ = nullptr;
   q.end_ = nullptr;
   q.size_queue_ = 0;
 }
 
-template <typename T>
-Queue<T>::~Queue() noexcept {
+template <typename T, typename Allocator>
+Queue<T, Allocator>::~Queue() noexcept {
   while (root_) {
     node* temp_ = root_->next_;
-    delete root_;
+    DestroyNode(root_);
     root_ = temp_;
   }
 }
 
-template <typename T>
-void Queue<T>::operator=(Queue&& q) noexcept {
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::operator=(Queue&& q) noexcept {
   if (this != &q) {
     while (root_) {
       node* temp_ = root_->next_;
-      delete root_;
+      DestroyNode(root_);
       root_ = temp_;
     }
+    end_ = nullptr;
+    size_queue_ = 0;
+    if (!node_traits::propagate_on_container_move_assignment::value &&
+        node_alloc_ != q.node_alloc_) {
+      for (node* current = q.root_; current; current = current->next_) {
+        Push(current->value_);
+      }
+      while (!q.Empty()) {
+        q.Pop();
+      }
+      return;
+    }
+    if constexpr (node_traits::propagate_on_container_move_assignment::
+                      value) {
+      node_alloc_ = std::move(q.node_alloc_);
+    }
     root_ = q.root_;
     end_ = q.end_;
     size_queue_ = q.size_queue_;
@@ -54,27 +79,29 @@ void Queue<T>::operator=(Queue&& q) noexcept {
   }
 }
 
-template <typename T>
-typename Queue<T>::const_reference Queue<T>::Front() const {
+template <typename T, typename Allocator>
+typename Queue<T, Allocator>::const_reference Queue<T, Allocator>::Front()
+    const {
   if (Empty()) {
     throw std::out_of_range("Queue is Empty");
   }
   return root_->value_;
 }
 
-template <typename T>
-bool Queue<T>::Empty() const noexcept {
+template <typename T, typename Allocator>
+bool Queue<T, Allocator>::Empty() const noexcept {
   return size_queue_ == 0;
 }
 
-template <typename T>
-typename Queue<T>::size_type Queue<T>::Size() const noexcept {
+template <typename T, typename Allocator>
+typename Queue<T, Allocator>::size_type Queue<T, Allocator>::Size()
+    const noexcept {
   return size_queue_;
 }
 
-template <typename T>
-void Queue<T>::Push(const_reference value) noexcept {
-  node* new_node_ = new node{value, nullptr};
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::Push(const_reference value) noexcept {
+  node* new_node_ = CreateNode(value);
   if (Empty()) {
     root_ = new_node_;
     end_ = new_node_;
@@ -85,12 +112,12 @@ void Queue<T>::Push(const_reference value) noexcept {
   ++size_queue_;
 }
 
-template <typename T>
-void Queue<T>::Pop() noexcept {
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::Pop() noexcept {
   if (!Empty()) {
     node* temp_ = root_;
     root_ = root_->next_;
-    delete temp_;
+    DestroyNode(temp_);
 
     if (root_ == nullptr) {
       end_ = nullptr;
@@ -99,8 +126,8 @@ void Queue<T>::Pop() noexcept {
   }
 }
 
-template <typename T>
-void Queue<T>::Swap(Queue& other) noexcept {
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::Swap(Queue& other) noexcept {
   node* tmp_root_ = root_;
   node* tmp_end_ = end_;
   root_ = other.root_;
@@ -111,6 +138,35 @@ void Queue<T>::Swap(Queue& other) noexcept {
   size_type tmp_size_ = size_queue_;
   size_queue_ = other.size_queue_;
   other.size_queue_ = tmp_size_;
+
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(node_alloc_, other.node_alloc_);
+  }
+}
+
+template <typename T, typename Allocator>
+typename Queue<T, Allocator>::allocator_type
+Queue<T, Allocator>::GetAllocator() const noexcept {
+  return allocator_type(node_alloc_);
+}
+
+template <typename T, typename Allocator>
+typename Queue<T, Allocator>::node* Queue<T, Allocator>::CreateNode(
+    const_reference value) {
+  node* new_node = node_traits::allocate(node_alloc_, 1);
+  try {
+    node_traits::construct(node_alloc_, new_node, value, nullptr);
+  } catch (...) {
+    node_traits::deallocate(node_alloc_, new_node, 1);
+    throw;
+  }
+  return new_node;
+}
+
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::DestroyNode(node* old_node) noexcept {
+  node_traits::destroy(node_alloc_, old_node);
+  node_traits::deallocate(node_alloc_, old_node, 1);
 }
 
 }  // namespace s21
@@ -4,54 +4,149 @@
 #include "../general_structures/container.h"
 
 namespace s21 {
-template <typename Key>
-class Set : public Container<Key, Key> {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Augment = NoAugment>
+class Set : public Container<Key, void, Compare, Allocator, Augment> {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename Container<Key, Key>::iterator;
-  using const_iterator = typename Container<Key, Key>::const_iterator;
+  using iterator =
+      typename Container<Key, void, Compare, Allocator, Augment>::iterator;
+  using const_iterator = typename Container<Key, void, Compare, Allocator,
+                                            Augment>::const_iterator;
   using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type =
+      typename Container<Key, void, Compare, Allocator, Augment>::node_type;
 
   Set() noexcept = default;
-  Set(std::initializer_list<value_type> const& items) noexcept : Set<Key>() {
+  explicit Set(const Allocator& alloc) noexcept
+      : Container<Key, void, Compare, Allocator, Augment>(alloc) {}
+  explicit Set(const Compare& comp,
+               const Allocator& alloc = Allocator()) noexcept
+      : Container<Key, void, Compare, Allocator, Augment>(comp, alloc) {}
+  Set(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator()) noexcept
+      : Set(comp, alloc) {
     for (const auto& item : items) {
       Insert(item);
     }
   }
-  Set(const Set& s) noexcept = default;
+  Set(std::initializer_list<value_type> const& items,
+      const Allocator& alloc) noexcept
+      : Set(items, Compare(), alloc) {}
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Set(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : Set(comp, alloc) {
+    BuildFromSorted(first, last);
+  }
+  template <typename ForwardIt,
+            typename = typename std::iterator_traits<
+                ForwardIt>::iterator_category>
+  Set(ForwardIt first, ForwardIt last, const Allocator& alloc)
+      : Set(first, last, Compare(), alloc) {}
+  Set(const Set& s) = default;
   Set(Set&& other) noexcept = default;
   ~Set() = default;
-  Set<Key>& operator=(Set&& other) noexcept = default;
-  Set<Key>& operator=(const Set& other) noexcept = default;
+  Set& operator=(Set&& other) noexcept = default;
+  Set& operator=(const Set& other) = default;
+
+  using Container<Key, void, Compare, Allocator, Augment>::Insert;
+
+  std::pair<iterator, bool> Insert(Key&& key) {
+    return EmplaceUnique(nullptr, key, std::piecewise_construct,
+                         std::forward_as_tuple(std::move(key)),
+                         std::tuple<>());
+  }
+
+  iterator Insert(iterator hint, Key&& key) {
+    return EmplaceUnique(hint.getCurrent(), key, std::piecewise_construct,
+                         std::forward_as_tuple(std::move(key)),
+                         std::tuple<>())
+        .first;
+  }
+
+  // Constructs the key inside its node from args. A single Key argument is
+  // looked up first, so nothing is built if it is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args&&... args) {
+    return EmplaceAt(nullptr, std::forward<Args>(args)...);
+  }
+
+  // Emplace that uses hint the same way as Insert(hint, value).
+  template <typename... Args>
+  iterator EmplaceHint(iterator hint, Args&&... args) {
+    return EmplaceAt(hint.getCurrent(), std::forward<Args>(args)...).first;
+  }
+
+  using Container<Key, void, Compare, Allocator, Augment>::BuildFromSorted;
 
-  using Container<Key, Key>::Insert;
+  using Container<Key, void, Compare, Allocator, Augment>::Begin;
+  using Container<Key, void, Compare, Allocator, Augment>::End;
+  using Container<Key, void, Compare, Allocator, Augment>::CBegin;
+  using Container<Key, void, Compare, Allocator, Augment>::CEnd;
 
-  using Container<Key, Key>::Begin;
-  using Container<Key, Key>::End;
-  using Container<Key, Key>::CBegin;
-  using Container<Key, Key>::CEnd;
+  using Container<Key, void, Compare, Allocator, Augment>::Clear;
+  using Container<Key, void, Compare, Allocator, Augment>::Merge;
+  using Container<Key, void, Compare, Allocator, Augment>::Split;
+  using Container<Key, void, Compare, Allocator, Augment>::Join;
+  using Container<Key, void, Compare, Allocator, Augment>::Union;
+  using Container<Key, void, Compare, Allocator, Augment>::Intersection;
+  using Container<Key, void, Compare, Allocator, Augment>::Difference;
+  using Container<Key, void, Compare, Allocator, Augment>::Swap;
+  using Container<Key, void, Compare, Allocator, Augment>::Erase;
+  using Container<Key, void, Compare, Allocator, Augment>::Extract;
 
-  using Container<Key, Key>::Clear;
-  using Container<Key, Key>::Merge;
-  using Container<Key, Key>::Swap;
-  using Container<Key, Key>::Erase;
+  using Container<Key, void, Compare, Allocator, Augment>::Find;
+  using Container<Key, void, Compare, Allocator, Augment>::Contains;
+  using Container<Key, void, Compare, Allocator, Augment>::Count;
+  using Container<Key, void, Compare, Allocator, Augment>::LowerBound;
+  using Container<Key, void, Compare, Allocator, Augment>::UpperBound;
+  using Container<Key, void, Compare, Allocator, Augment>::EqualRange;
 
-  using Container<Key, Key>::Find;
-  using Container<Key, Key>::Contains;
+  using Container<Key, void, Compare, Allocator, Augment>::Empty;
+  using Container<Key, void, Compare, Allocator, Augment>::Size;
+  using Container<Key, void, Compare, Allocator, Augment>::MaxSize;
+  using Container<Key, void, Compare, Allocator, Augment>::Reserve;
+  using Container<Key, void, Compare, Allocator, Augment>::GetAllocator;
+  using Container<Key, void, Compare, Allocator, Augment>::KeyComp;
 
-  using Container<Key, Key>::Empty;
-  using Container<Key, Key>::Size;
-  using Container<Key, Key>::MaxSize;
+  using Container<Key, void, Compare, Allocator, Augment>::Rank;
+  using Container<Key, void, Compare, Allocator, Augment>::Select;
+  using Container<Key, void, Compare, Allocator, Augment>::Advance;
 
-  using Container<Key, Key>::GetRoot;
+  using Container<Key, void, Compare, Allocator, Augment>::GetRoot;
 
  private:
-  using Container<Key, Key>::root_;
-  using Container<Key, Key>::dummy_;
-  using Container<Key, Key>::size_cont_;
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceAt(Node<Key, void, Augment>* hint,
+                                      Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same_v<std::decay_t<Args>, Key> && ...)) {
+      return EmplaceUnique(hint, args..., std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<Args>(args)...),
+                           std::tuple<>());
+    } else {
+      return EmplaceNode(hint, std::piecewise_construct,
+                         std::forward_as_tuple(std::forward<Args>(args)...),
+                         std::tuple<>());
+    }
+  }
+
+  using Container<Key, void, Compare, Allocator, Augment>::EmplaceNode;
+  using Container<Key, void, Compare, Allocator, Augment>::EmplaceUnique;
+  using Container<Key, void, Compare, Allocator, Augment>::root_;
+  using Container<Key, void, Compare, Allocator, Augment>::leftmost_;
+  using Container<Key, void, Compare, Allocator, Augment>::dummy_;
+  using Container<Key, void, Compare, Allocator, Augment>::size_cont_;
 };
 
 }  // namespace s21
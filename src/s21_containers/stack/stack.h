@@ -3,18 +3,22 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Stack {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
 
   Stack() noexcept;
-  Stack(std::initializer_list<value_type> const& items) noexcept;
+  explicit Stack(const Allocator& alloc) noexcept;
+  Stack(std::initializer_list<value_type> const& items,
+        const Allocator& alloc = Allocator()) noexcept;
   Stack(const Stack& s) noexcept;
   Stack(Stack&& s) noexcept;
   ~Stack() noexcept;
@@ -29,16 +33,27 @@ class Stack {
   void Pop() noexcept;
   void Swap(Stack& other) noexcept;
 
+  allocator_type GetAllocator() const noexcept;
+
  private:
   void Clear() noexcept;
 
   struct node {
     value_type value_;
     node* next_;
+    node(const value_type& value, node* next) : value_(value), next_(next) {}
   };
 
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  node* CreateNode(const_reference value, node* next);
+  void DestroyNode(node* old_node) noexcept;
+
   node* root_;
   size_type size_stack_ = 0;
+  node_allocator node_alloc_;
 };
 }  // namespace s21
 #include "stack.tpp"
@@ -1,13 +1,19 @@
 namespace s21 {
 
-template <typename T>
-Stack<T>::Stack() noexcept {
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack() noexcept : Stack(Allocator()) {}
+
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(const Allocator& alloc) noexcept
+    : node_alloc_(alloc) {
   size_stack_ = 0;
   root_ = nullptr;
 }
 
-template <typename T>
-Stack<T>::Stack(std::initializer_list<value_type> const& items) noexcept {
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(std::initializer_list<value_type> const& items,
+                           const Allocator& alloc) noexcept
+    : node_alloc_(alloc) {
   size_stack_ = 0;
   root_ = nullptr;
   for (const value_type& item : items) {
@@ -15,71 +21,66 @@ Stack<T>::Stack(std::initializer_list<value_type> const& items) noexcept {
   }
 }
 
-template <typename T>
-Stack<T>::Stack(const Stack& s) noexcept {
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(const Stack& s) noexcept
+    : node_alloc_(
+          node_traits::select_on_container_copy_construction(s.node_alloc_)) {
   size_stack_ = s.size_stack_;
   root_ = nullptr;
   if (s.root_ != nullptr) {
-    root_ = new node{s.root_->value_, nullptr};
+    root_ = CreateNode(s.root_->value_, nullptr);
     node* current = root_;
     node* current_s = s.root_->next_;
     while (current_s != nullptr) {
-      current->next_ = new node{current_s->value_, nullptr};
+      current->next_ = CreateNode(current_s->value_, nullptr);
       current = current->next_;
       current_s = current_s->next_;
     }
   }
 }
 
-template <typename T>
-Stack<T>::Stack(Stack&& s) noexcept {
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(Stack&& s) noexcept
+    : node_alloc_(std::move(s.node_alloc_)) {
   size_stack_ = s.size_stack_;
   root_ = s.root_;
   s.size_stack_ = 0;
   s.root_ = nullptr;
 }
 
-template <typename T>
-Stack<T>::~Stack() noexcept {
+template <typename T, typename Allocator>
+Stack<T, Allocator>::~Stack() noexcept {
   Clear();
 }
 
-template <typename T>
-void Stack<T>::Clear() noexcept {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::Clear() noexcept {
   while (root_ != nullptr) {
     node* tmp = root_;
     root_ = root_->next_;
-    delete tmp;
+    DestroyNode(tmp);
   }
   size_stack_ = 0;
 }
 
-template <typename T>
-void Stack<T>::Push(const_reference value) noexcept {
-  node* tmp = new node;
-  tmp->value_ = value;
-  if (root_) {
-    tmp->next_ = root_;
-    root_ = tmp;
-  } else {
-    root_ = tmp;
-    root_->next_ = nullptr;
-  }
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::Push(const_reference value) noexcept {
+  root_ = CreateNode(value, root_);
   size_stack_++;
 }
 
-template <typename T>
-void Stack<T>::Pop() noexcept {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::Pop() noexcept {
   if (root_) {
     node* tmp = root_->next_;
-    delete root_;
+    DestroyNode(root_);
     root_ = tmp;
     size_stack_--;
   }
 }
 
-template <typename T>
-void Stack<T>::Swap(Stack& other) noexcept {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::Swap(Stack& other) noexcept {
   node* tmp = root_;
   root_ = other.root_;
   other.root_ = tmp;
@@ -87,25 +88,44 @@ void Stack<T>::Swap(Stack& other) noexcept {
   size_type tmp_size = size_stack_;
   size_stack_ = other.size_stack_;
   other.size_stack_ = tmp_size;
+
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(node_alloc_, other.node_alloc_);
+  }
 }
 
-template <typename T>
-bool Stack<T>::Empty() const noexcept {
+template <typename T, typename Allocator>
+bool Stack<T, Allocator>::Empty() const noexcept {
   return root_ == nullptr;
 }
 
-template <typename T>
-typename Stack<T>::const_reference Stack<T>::Top() const {
+template <typename T, typename Allocator>
+typename Stack<T, Allocator>::const_reference Stack<T, Allocator>::Top() const {
   if (root_ == nullptr) {
     throw std::out_of_range("Stack is empty.");
   }
   return root_->value_;
 }
 
-template <typename T>
-void Stack<T>::operator=(Stack&& s) noexcept {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::operator=(Stack&& s) noexcept {
   if (this != &s) {
     Clear();
+    if (!node_traits::propagate_on_container_move_assignment::value &&
+        node_alloc_ != s.node_alloc_) {
+      node** tail = &root_;
+      for (node* current = s.root_; current; current = current->next_) {
+        *tail = CreateNode(current->value_, nullptr);
+        tail = &(*tail)->next_;
+      }
+      size_stack_ = s.size_stack_;
+      s.Clear();
+      return;
+    }
+    if constexpr (node_traits::propagate_on_container_move_assignment::
+                      value) {
+      node_alloc_ = std::move(s.node_alloc_);
+    }
     size_stack_ = s.size_stack_;
     root_ = s.root_;
     s.size_stack_ = 0;
@@ -113,9 +133,35 @@ void Stack<T>::operator=(Stack&& s) noexcept {
   }
 }
 
-template <typename T>
-typename Stack<T>::size_type Stack<T>::Size() const noexcept {
+template <typename T, typename Allocator>
+typename Stack<T, Allocator>::size_type Stack<T, Allocator>::Size()
+    const noexcept {
   return size_stack_;
 }
 
+template <typename T, typename Allocator>
+typename Stack<T, Allocator>::allocator_type
+Stack<T, Allocator>::GetAllocator() const noexcept {
+  return allocator_type(node_alloc_);
+}
+
+template <typename T, typename Allocator>
+typename Stack<T, Allocator>::node* Stack<T, Allocator>::CreateNode(
+    const_reference value, node* next) {
+  node* new_node = node_traits::allocate(node_alloc_, 1);
+  try {
+    node_traits::construct(node_alloc_, new_node, value, next);
+  } catch (...) {
+    node_traits::deallocate(node_alloc_, new_node, 1);
+    throw;
+  }
+  return new_node;
+}
+
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::DestroyNode(node* old_node) noexcept {
+  node_traits::destroy(node_alloc_, old_node);
+  node_traits::deallocate(node_alloc_, old_node, 1);
+}
+
 }  // namespace s21
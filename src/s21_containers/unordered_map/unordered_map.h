@@ -0,0 +1,206 @@
+#ifndef SRC_S21_CONTAINERS_UNORDERED_MAP_UNORDERED_MAP_H_
+#define SRC_S21_CONTAINERS_UNORDERED_MAP_UNORDERED_MAP_H_
+
+#include "../general_structures/hash_table.h"
+
+namespace s21 {
+
+// Map on an open-addressing hash table, for point lookups that need no
+// order: a lookup reads one group of control bytes and, nearly always,
+// one key. It has the Map interface without ordered queries, hints, node
+// handles or augmentation, plus Reserve and Rehash. Iterators only move
+// forward; erasure keeps the others valid, growth does not.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class UnorderedMap : public HashTable<Key, T, Hash, KeyEqual, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename HashTable<Key, T, Hash, KeyEqual, Allocator>::iterator;
+  using const_iterator =
+      typename HashTable<Key, T, Hash, KeyEqual, Allocator>::const_iterator;
+  using size_type =
+      typename HashTable<Key, T, Hash, KeyEqual, Allocator>::size_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  UnorderedMap() noexcept = default;
+  explicit UnorderedMap(const Allocator& alloc) noexcept
+      : HashTable<Key, T, Hash, KeyEqual, Allocator>(alloc) {}
+  explicit UnorderedMap(const Hash& hash, const KeyEqual& equal = KeyEqual(),
+                        const Allocator& alloc = Allocator()) noexcept
+      : HashTable<Key, T, Hash, KeyEqual, Allocator>(hash, equal, alloc) {}
+  UnorderedMap(std::initializer_list<value_type> const& items,
+               const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+               const Allocator& alloc = Allocator())
+      : UnorderedMap(items.begin(), items.end(), hash, equal, alloc) {}
+  UnorderedMap(std::initializer_list<value_type> const& items,
+               const Allocator& alloc)
+      : UnorderedMap(items, Hash(), KeyEqual(), alloc) {}
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  UnorderedMap(InputIt first, InputIt last, const Hash& hash = Hash(),
+               const KeyEqual& equal = KeyEqual(),
+               const Allocator& alloc = Allocator())
+      : UnorderedMap(hash, equal, alloc) {
+    for (; first != last; ++first) {
+      Insert(*first);
+    }
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  UnorderedMap(InputIt first, InputIt last, const Allocator& alloc)
+      : UnorderedMap(first, last, Hash(), KeyEqual(), alloc) {}
+  UnorderedMap(const UnorderedMap& other) = default;
+  UnorderedMap(UnorderedMap&& other) noexcept = default;
+  ~UnorderedMap() = default;
+  UnorderedMap& operator=(UnorderedMap&& other) noexcept = default;
+  UnorderedMap& operator=(const UnorderedMap& other) = default;
+
+  std::pair<iterator, bool> Insert(const value_type& value) {
+    return TryEmplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> Insert(value_type&& value) {
+    return TryEmplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> Insert(const Key& key, const T& obj) {
+    return TryEmplace(key, obj);
+  }
+
+  // Constructs the element in place from (key, obj), a pair, or a
+  // piecewise_construct pair of tuples. A key not given as a Key is built
+  // first to be hashed.
+  template <typename K, typename M>
+  std::pair<iterator, bool> Emplace(K&& key, M&& obj) {
+    if constexpr (std::is_same_v<std::decay_t<K>, Key>) {
+      return EmplaceUnique(key, std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    } else {
+      Key built(std::forward<K>(key));
+      return EmplaceUnique(built, std::forward_as_tuple(std::move(built)),
+                           std::forward_as_tuple(std::forward<M>(obj)));
+    }
+  }
+
+  template <typename P>
+  std::pair<iterator, bool> Emplace(P&& value) {
+    return Emplace(std::get<0>(std::forward<P>(value)),
+                   std::get<1>(std::forward<P>(value)));
+  }
+
+  template <typename... KeyArgs, typename... ValArgs>
+  std::pair<iterator, bool> Emplace(std::piecewise_construct_t,
+                                    std::tuple<KeyArgs...> key_args,
+                                    std::tuple<ValArgs...> val_args) {
+    Key built = std::make_from_tuple<Key>(std::move(key_args));
+    return EmplaceUnique(built, std::forward_as_tuple(std::move(built)),
+                         std::move(val_args));
+  }
+
+  // Inserts a value built from args only if key is missing; otherwise args
+  // are left untouched.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+    return EmplaceUnique(key, std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+    return EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // As in Map, second tells whether a new element was inserted.
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(const Key& key, M&& obj) {
+    auto result = TryEmplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> InsertOrAssign(Key&& key, M&& obj) {
+    auto result = TryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      ValueAt(result.first) = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  // second is also true when an existing element got a different value.
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    auto result = TryEmplace(key, obj);
+    if (!result.second && ValueAt(result.first) != obj) {
+      ValueAt(result.first) = obj;
+      result.second = true;
+    }
+    return result;
+  }
+
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Begin;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::End;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::CBegin;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::CEnd;
+
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Merge;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Clear;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Swap;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Erase;
+
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Find;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Contains;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Count;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::EqualRange;
+
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Empty;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Size;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::MaxSize;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::GetAllocator;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::HashFunction;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::KeyEq;
+
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::BucketCount;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::LoadFactor;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Reserve;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::Rehash;
+
+  T& At(const Key& key) {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in UnorderedMap");
+    }
+    return ValueAt(it);
+  }
+  const T& At(const Key& key) const {
+    iterator it = Find(key);
+    if (it == End()) {
+      throw std::out_of_range("Key not found in UnorderedMap");
+    }
+    return it.GetVal();
+  }
+  T& operator[](const Key& key) { return ValueAt(TryEmplace(key).first); }
+  T& operator[](Key&& key) {
+    return ValueAt(TryEmplace(std::move(key)).first);
+  }
+
+ private:
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::EmplaceUnique;
+  using HashTable<Key, T, Hash, KeyEqual, Allocator>::ValueAt;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_CONTAINERS_UNORDERED_MAP_UNORDERED_MAP_H_
@@ -0,0 +1,119 @@
+#ifndef SRC_S21_CONTAINERS_UNORDERED_SET_UNORDERED_SET_H_
+#define SRC_S21_CONTAINERS_UNORDERED_SET_UNORDERED_SET_H_
+
+#include "../general_structures/hash_table.h"
+
+namespace s21 {
+
+// Set on an open-addressing hash table; see UnorderedMap.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class UnorderedSet : public HashTable<Key, void, Hash, KeyEqual, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator =
+      typename HashTable<Key, void, Hash, KeyEqual, Allocator>::iterator;
+  using const_iterator =
+      typename HashTable<Key, void, Hash, KeyEqual, Allocator>::const_iterator;
+  using size_type =
+      typename HashTable<Key, void, Hash, KeyEqual, Allocator>::size_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  UnorderedSet() noexcept = default;
+  explicit UnorderedSet(const Allocator& alloc) noexcept
+      : HashTable<Key, void, Hash, KeyEqual, Allocator>(alloc) {}
+  explicit UnorderedSet(const Hash& hash, const KeyEqual& equal = KeyEqual(),
+                        const Allocator& alloc = Allocator()) noexcept
+      : HashTable<Key, void, Hash, KeyEqual, Allocator>(hash, equal, alloc) {}
+  UnorderedSet(std::initializer_list<value_type> const& items,
+               const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+               const Allocator& alloc = Allocator())
+      : UnorderedSet(items.begin(), items.end(), hash, equal, alloc) {}
+  UnorderedSet(std::initializer_list<value_type> const& items,
+               const Allocator& alloc)
+      : UnorderedSet(items, Hash(), KeyEqual(), alloc) {}
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  UnorderedSet(InputIt first, InputIt last, const Hash& hash = Hash(),
+               const KeyEqual& equal = KeyEqual(),
+               const Allocator& alloc = Allocator())
+      : UnorderedSet(hash, equal, alloc) {
+    for (; first != last; ++first) {
+      Insert(*first);
+    }
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<
+                InputIt>::iterator_category>
+  UnorderedSet(InputIt first, InputIt last, const Allocator& alloc)
+      : UnorderedSet(first, last, Hash(), KeyEqual(), alloc) {}
+  UnorderedSet(const UnorderedSet& other) = default;
+  UnorderedSet(UnorderedSet&& other) noexcept = default;
+  ~UnorderedSet() = default;
+  UnorderedSet& operator=(UnorderedSet&& other) noexcept = default;
+  UnorderedSet& operator=(const UnorderedSet& other) = default;
+
+  std::pair<iterator, bool> Insert(const Key& key) {
+    return EmplaceUnique(key, std::forward_as_tuple(key), std::tuple<>());
+  }
+
+  std::pair<iterator, bool> Insert(Key&& key) {
+    return EmplaceUnique(key, std::forward_as_tuple(std::move(key)),
+                         std::tuple<>());
+  }
+
+  // Builds the key from args, then inserts it unless it is present. A
+  // single Key argument is looked up without building anything.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same_v<std::decay_t<Args>, Key> && ...)) {
+      return EmplaceUnique(args...,
+                           std::forward_as_tuple(std::forward<Args>(args)...),
+                           std::tuple<>());
+    } else {
+      Key built(std::forward<Args>(args)...);
+      return Insert(std::move(built));
+    }
+  }
+
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Begin;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::End;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::CBegin;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::CEnd;
+
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Clear;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Merge;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Swap;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Erase;
+
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Find;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Contains;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Count;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::EqualRange;
+
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Empty;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Size;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::MaxSize;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::GetAllocator;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::HashFunction;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::KeyEq;
+
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::BucketCount;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::LoadFactor;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Reserve;
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::Rehash;
+
+ private:
+  using HashTable<Key, void, Hash, KeyEqual, Allocator>::EmplaceUnique;
+};
+
+}  // namespace s21
+#endif  // SRC_S21_CONTAINERS_UNORDERED_SET_UNORDERED_SET_H_
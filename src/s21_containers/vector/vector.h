@@ -1,18 +1,21 @@
 #ifndef SRC_S21_CONTAINERS_VECTOR_VECTOR_H_
 #define SRC_S21_CONTAINERS_VECTOR_VECTOR_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 
 #include "vector_iterators.h"
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Vector {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
   using iterator = VectorIterator<T>;
@@ -20,8 +23,10 @@ class Vector {
   using size_type = std::size_t;
 
   Vector();
-  Vector(size_type n);
-  Vector(std::initializer_list<value_type> const& items);
+  explicit Vector(const Allocator& alloc);
+  Vector(size_type n, const Allocator& alloc = Allocator());
+  Vector(std::initializer_list<value_type> const& items,
+         const Allocator& alloc = Allocator());
   Vector(const Vector& v);
   Vector(Vector&& v);
   ~Vector();
@@ -32,27 +37,39 @@ class Vector {
   const_reference Front();
   const_reference Back();
   T* Data();
+  const T* Data() const;
 
   iterator Begin();
   iterator End();
 
-  bool Empty();
-  size_type Size();
-  size_type MaxSize();
+  bool Empty() const;
+  size_type Size() const;
+  size_type MaxSize() const;
   void Reserve(size_type size);
-  size_type Capacity();
+  size_type Capacity() const;
   void ShrinkToFit();
   void Clear();
   iterator Insert(iterator pos, const_reference value);
+  iterator Insert(iterator pos, value_type&& value);
   void Erase(iterator pos);
+  void Erase(iterator first, iterator last);
   void PushBack(const_reference value);
+  void PushBack(value_type&& value);
   void PopBack();
   void Swap(Vector& other);
 
+  allocator_type GetAllocator() const;
+
  private:
+  using traits = std::allocator_traits<Allocator>;
+
+  void Reallocate(size_type capacity);
+  void Deallocate() noexcept;
+
   T* arr_;
   size_type size_;
   size_type capacity_;
+  Allocator alloc_;
 };
 
 }  // namespace s21
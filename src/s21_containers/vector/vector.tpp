@@ -1,36 +1,43 @@
 namespace s21 {
 
-template <typename T>
-Vector<T>::Vector() : arr_(nullptr), size_(0), capacity_(0) {}
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector() : Vector(Allocator()) {}
 
-template <typename T>
-Vector<T>::Vector(size_type n)
-    : arr_(new value_type[n]), size_(n), capacity_(n) {
-  if (arr_ == nullptr) {
-    throw std::bad_alloc();
-  }
-  for (size_type i = 0; i < n; ++i) {
-    arr_[i] = T();
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const Allocator& alloc)
+    : arr_(nullptr), size_(0), capacity_(0), alloc_(alloc) {}
+
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(size_type n, const Allocator& alloc)
+    : Vector(alloc) {
+  Reallocate(n);
+  for (; size_ < n; ++size_) {
+    traits::construct(alloc_, arr_ + size_);
   }
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<value_type> const& items)
-    : Vector(items.size()) {
-  for (size_type i = 0; i < size_; ++i) {
-    arr_[i] = *(items.begin() + i);
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(std::initializer_list<value_type> const& items,
+                             const Allocator& alloc)
+    : Vector(alloc) {
+  Reallocate(items.size());
+  for (const_reference item : items) {
+    traits::construct(alloc_, arr_ + size_, item);
+    ++size_;
   }
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector& v) : Vector(v.size_) {
-  for (size_type i = 0; i < size_; ++i) {
-    arr_[i] = v.arr_[i];
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const Vector& v)
+    : Vector(traits::select_on_container_copy_construction(v.alloc_)) {
+  Reallocate(v.size_);
+  for (; size_ < v.size_; ++size_) {
+    traits::construct(alloc_, arr_ + size_, v.arr_[size_]);
   }
 }
 
-template <typename T>
-Vector<T>::Vector(Vector&& v) {
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(Vector&& v) : alloc_(std::move(v.alloc_)) {
   arr_ = v.arr_;
   size_ = v.size_;
   capacity_ = v.capacity_;
@@ -39,89 +46,109 @@ Vector<T>::Vector(Vector&& v) {
   v.capacity_ = 0;
 }
 
-template <typename T>
-Vector<T>::~Vector() {
-  delete[] arr_;
-  arr_ = nullptr;
-  size_ = 0;
-  capacity_ = 0;
+template <typename T, typename Allocator>
+Vector<T, Allocator>::~Vector() {
+  Deallocate();
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector<T>&& v) {
+template <typename T, typename Allocator>
+Vector<T, Allocator>& Vector<T, Allocator>::operator=(
+    Vector<T, Allocator>&& v) {
   if (this != &v) {
-    delete[] arr_;
-    arr_ = v.arr_;
-    size_ = v.size_;
-    capacity_ = v.capacity_;
-    v.arr_ = nullptr;
-    v.size_ = 0;
-    v.capacity_ = 0;
+    if (traits::propagate_on_container_move_assignment::value ||
+        alloc_ == v.alloc_) {
+      Deallocate();
+      if constexpr (traits::propagate_on_container_move_assignment::value) {
+        alloc_ = std::move(v.alloc_);
+      }
+      arr_ = v.arr_;
+      size_ = v.size_;
+      capacity_ = v.capacity_;
+      v.arr_ = nullptr;
+      v.size_ = 0;
+      v.capacity_ = 0;
+    } else {
+      Clear();
+      Reserve(v.size_);
+      for (; size_ < v.size_; ++size_) {
+        traits::construct(alloc_, arr_ + size_, std::move(v.arr_[size_]));
+      }
+      v.Clear();
+    }
   }
   return *this;
 }
 
-template <typename T>
-typename Vector<T>::reference Vector<T>::At(size_type pos) {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::reference Vector<T, Allocator>::At(
+    size_type pos) {
   if (pos >= size_ || size_ == 0) {
     throw std::out_of_range("Index out range");
   }
   return arr_[pos];
 }
 
-template <typename T>
-typename Vector<T>::reference Vector<T>::operator[](size_type pos) {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::reference Vector<T, Allocator>::operator[](
+    size_type pos) {
   return arr_[pos];
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::Front() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::Front() {
   if (Empty()) {
     throw std::out_of_range("Container is Empty");
   }
   return arr_[0];
 }
 
-template <typename T>
-typename Vector<T>::const_reference Vector<T>::Back() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::Back() {
   if (Empty()) {
     throw std::out_of_range("Container is Empty");
   }
   return arr_[size_ - 1];
 }
 
-template <typename T>
-T* Vector<T>::Data() {
+template <typename T, typename Allocator>
+T* Vector<T, Allocator>::Data() {
   return arr_;
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::Begin() {
+template <typename T, typename Allocator>
+const T* Vector<T, Allocator>::Data() const {
+  return arr_;
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::Begin() {
   return iterator(arr_);
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::End() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::End() {
   return iterator(arr_ + size_);
 }
 
-template <typename T>
-bool Vector<T>::Empty() {
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::Empty() const {
   return size_ == 0;
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::Size() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::Size() const {
   return size_;
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::MaxSize() {
-  return std::numeric_limits<std::size_t>::max() / sizeof(value_type) / 2;
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::MaxSize() const {
+  size_type max_size =
+      std::numeric_limits<std::size_t>::max() / sizeof(value_type) / 2;
+  return std::min(max_size, traits::max_size(alloc_));
 }
 
-template <typename T>
-void Vector<T>::Reserve(size_type size) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Reserve(size_type size) {
   if (size <= capacity_) {
     return;
   }
@@ -131,81 +158,151 @@ void Vector<T>::Reserve(size_type size) {
         "Reserve capacity can't be larger than MaxSize of Vector");
   }
 
-  Vector<value_type> Tmp(size);
-  for (size_type i = 0; i < size_; ++i) {
-    Tmp.arr_[i] = arr_[i];
-  }
-  Tmp.size_ = size_;
-  *this = std::move(Tmp);
+  Reallocate(size);
 }
 
-template <typename T>
-typename Vector<T>::size_type Vector<T>::Capacity() {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::size_type Vector<T, Allocator>::Capacity()
+    const {
   return capacity_;
 }
 
-template <typename T>
-void Vector<T>::ShrinkToFit() {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::ShrinkToFit() {
   if (size_ < capacity_) {
-    Vector<value_type> tmp(size_);
-    for (size_type i = 0; i < size_; ++i) {
-      tmp.arr_[i] = arr_[i];
-    }
-    *this = std::move(tmp);
+    Reallocate(size_);
   }
 }
 
-template <typename T>
-void Vector<T>::Clear() {
-  size_ = 0;
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Clear() {
+  while (size_ > 0) {
+    PopBack();
+  }
 }
 
-template <typename T>
-typename Vector<T>::iterator Vector<T>::Insert(iterator pos,
-                                               const_reference value) {
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::Insert(
+    iterator pos, const_reference value) {
+  return Insert(pos, value_type(value));
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::Insert(
+    iterator pos, value_type&& value) {
   size_type index = pos - Begin();
   if (index > size_) {
     throw std::out_of_range("Index out of range");
   }
+  // value may refer to an element, which the shift below overwrites.
+  value_type copy(std::move(value));
   if (size_ >= capacity_) {
     Reserve(size_ + 1);
   }
-  for (size_type i = size_; i > index; --i) {
-    arr_[i] = arr_[i - 1];
+  if (index == size_) {
+    traits::construct(alloc_, arr_ + size_, std::move(copy));
+  } else {
+    traits::construct(alloc_, arr_ + size_, std::move(arr_[size_ - 1]));
+    for (size_type i = size_ - 1; i > index; --i) {
+      arr_[i] = std::move(arr_[i - 1]);
+    }
+    arr_[index] = std::move(copy);
   }
   ++size_;
-  arr_[index] = value;
   return Begin() + index;
 }
 
-template <typename T>
-void Vector<T>::Erase(iterator pos) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Erase(iterator pos) {
   size_type index = pos - Begin();
   if (index > size_) {
     throw std::out_of_range("Index out of range");
   }
-  --size_;
-  for (size_type i = index; i < size_; ++i) {
-    arr_[i] = arr_[i + 1];
+  for (size_type i = index; i + 1 < size_; ++i) {
+    arr_[i] = std::move(arr_[i + 1]);
   }
+  PopBack();
 }
 
-template <typename T>
-void Vector<T>::PushBack(const_reference value) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Erase(iterator first, iterator last) {
+  size_type from = first - Begin();
+  size_type to = last - Begin();
+  if (from > to || to > size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  for (size_type i = to; i < size_; ++i) {
+    arr_[from + i - to] = std::move(arr_[i]);
+  }
+  for (size_type i = from; i < to; ++i) {
+    PopBack();
+  }
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::PushBack(const_reference value) {
   Insert(End(), value);
 }
 
-template <typename T>
-void Vector<T>::PopBack() {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::PushBack(value_type&& value) {
+  Insert(End(), std::move(value));
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::PopBack() {
   if (size_ > 0) {
     --size_;
+    traits::destroy(alloc_, arr_ + size_);
   }
 }
 
-template <typename T>
-void Vector<T>::Swap(Vector& other) {
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Swap(Vector& other) {
   std::swap(arr_, other.arr_);
   std::swap(size_, other.size_);
   std::swap(capacity_, other.capacity_);
+  if constexpr (traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::allocator_type
+Vector<T, Allocator>::GetAllocator() const {
+  return alloc_;
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Reallocate(size_type capacity) {
+  T* arr = capacity > 0 ? traits::allocate(alloc_, capacity) : nullptr;
+  size_type moved = 0;
+  try {
+    for (; moved < size_; ++moved) {
+      traits::construct(alloc_, arr + moved,
+                        std::move_if_noexcept(arr_[moved]));
+    }
+  } catch (...) {
+    while (moved > 0) {
+      traits::destroy(alloc_, arr + --moved);
+    }
+    traits::deallocate(alloc_, arr, capacity);
+    throw;
+  }
+  size_type size = size_;
+  Deallocate();
+  arr_ = arr;
+  size_ = size;
+  capacity_ = capacity;
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::Deallocate() noexcept {
+  Clear();
+  if (arr_ != nullptr) {
+    traits::deallocate(alloc_, arr_, capacity_);
+  }
+  arr_ = nullptr;
+  capacity_ = 0;
 }
 }  // namespace s21
@@ -1,10 +1,26 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <map>
+#include <memory>
+#include <new>
 #include <queue>
+#include <random>
+#include <set>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "s21_containers.h"
 
@@ -282,6 +298,28 @@ TEST(MapTest, InsertOrAssign) {
   EXPECT_EQ(map.At(2), "two");
 }
 
+namespace {
+
+// Compares by value_ only, so an assignment that keeps value_ shows in tag_.
+struct Tagged {
+  bool operator!=(const Tagged& other) const { return value_ != other.value_; }
+  int value_;
+  int tag_;
+};
+
+}  // namespace
+
+TEST(MapTest, InsertOrAssignAlwaysAssigns) {
+  s21::Map<int, Tagged> map;
+  EXPECT_TRUE(map.insert_or_assign(1, Tagged{5, 0}).second);
+  auto same = map.insert_or_assign(1, Tagged{5, 1});
+  EXPECT_FALSE(same.second);
+  EXPECT_EQ(same.first.GetVal().tag_, 1);
+  EXPECT_TRUE(map.insert_or_assign(1, Tagged{6, 2}).second);
+  EXPECT_EQ(map.At(1).value_, 6);
+  EXPECT_EQ(map.Size(), 1u);
+}
+
 TEST(MapTest, Erase) {
   s21::Map<int, char> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
   auto it = map.Begin();
@@ -403,6 +441,57 @@ TEST(MapTest, Merge3) {
   EXPECT_FALSE(map1.Empty());
 }
 
+TEST(MapTest, MergeRelinksNodes) {
+  s21::Map<int, std::string> base;
+  s21::Map<int, std::string> delta;
+  for (int i = 0; i < 2000; i += 2) {
+    base.Insert(i, "base");
+  }
+  // Most of delta moves, so its nodes are relinked rather than copied.
+  for (int i = 0; i < 6000; i += 3) {
+    delta.Insert(i, "delta");
+  }
+  auto* moved = delta.Find(3).getCurrent();
+  auto* kept = delta.Find(6).getCurrent();
+  base.Merge(delta);
+  EXPECT_EQ(base.Find(3).getCurrent(), moved);
+  EXPECT_EQ(delta.Find(6).getCurrent(), kept);
+  EXPECT_EQ(base.Size(), 1000 + 2000 - 334);
+  EXPECT_EQ(delta.Size(), 334);
+  EXPECT_EQ(base.At(6), "base");
+  EXPECT_EQ(base.At(9), "delta");
+  EXPECT_EQ(delta.Begin().GetKey(), 0);
+  int prev = -1;
+  for (auto it = base.Begin(); it != base.End(); ++it) {
+    EXPECT_LT(prev, it.GetKey());
+    prev = it.GetKey();
+  }
+  EXPECT_EQ(prev, 5997);
+}
+
+TEST(MapTest, MergedNodesOutliveSource) {
+  s21::Map<int, std::string> target;
+  {
+    s21::Map<int, std::string> source;
+    for (int i = 0; i < 100; ++i) {
+      source.Insert(i, std::string(32, 'x'));
+    }
+    target.Merge(source);
+    for (int i = 0; i < 50; ++i) {
+      source.Insert(i, "dup");
+    }
+    source.Merge(target);
+    EXPECT_EQ(target.Size(), 50);
+    target.Merge(source);
+    EXPECT_EQ(source.Size(), 50);
+  }
+  EXPECT_EQ(target.Size(), 100);
+  target.Erase(target.Find(50));
+  target.Insert(1000, "after");
+  EXPECT_EQ(target.At(99), std::string(32, 'x'));
+  EXPECT_EQ(target.At(1000), "after");
+}
+
 TEST(MapTest, Find) {
   s21::Map<int, char> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
 
@@ -414,6 +503,67 @@ TEST(MapTest, Find) {
   EXPECT_EQ(it, map.End());
 }
 
+TEST(MapTest, FindLarge) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.Insert((i * 7919) % 1000 * 2, i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    auto it = map.Find(i * 2);
+    ASSERT_NE(it, map.End());
+    EXPECT_EQ(it.GetKey(), i * 2);
+    EXPECT_FALSE(map.Contains(i * 2 + 1));
+  }
+  EXPECT_EQ(map.Find(-1), map.End());
+  EXPECT_EQ(map.Find(2000), map.End());
+}
+
+TEST(MapTest, BeginEndFollowErase) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 64; ++i) {
+    map.Insert((i * 37) % 64, i);
+  }
+  for (int low = 0, high = 63; low < high; ++low, --high) {
+    EXPECT_EQ(map.Begin().GetKey(), low);
+    auto last = map.End();
+    --last;
+    EXPECT_EQ(last.GetKey(), high);
+    map.Erase(map.Begin());
+    map.Erase(last);
+  }
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Begin(), map.End());
+}
+
+TEST(MapTest, IterateAfterErase) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 200; ++i) {
+    map.Insert((i * 71) % 200, i);
+  }
+  for (int i = 0; i < 200; i += 3) {
+    map.Erase(map.Find(i));
+  }
+  int expected = 1;
+  for (auto it = map.Begin(); it != map.End(); ++it) {
+    EXPECT_EQ(it.GetKey(), expected);
+    expected += (expected % 3 == 1) ? 1 : 2;
+  }
+  EXPECT_EQ(expected, 200);
+}
+
+TEST(MapTest, ClearThenReuse) {
+  s21::Map<int, char> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  map.Clear();
+  EXPECT_EQ(map.Begin(), map.End());
+  map.Insert(7, 'x');
+  map.Insert(5, 'y');
+  EXPECT_EQ(map.Begin().GetKey(), 5);
+  auto last = map.End();
+  --last;
+  EXPECT_EQ(last.GetKey(), 7);
+  EXPECT_TRUE(map.Contains(5));
+}
+
 TEST(MapTest, Contains) {
   s21::Map<int, char> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
   EXPECT_TRUE(map.Contains(1));
@@ -676,6 +826,17 @@ TEST(MapTest, MaxSize) {
   EXPECT_EQ(map.MaxSize(), 230584300921369395);
 }
 
+TEST(MapTest, PrintTreeSkipsEndNodes) {
+  s21::Map<int, int> map{{2, 20}, {1, 10}, {3, 30}};
+  testing::internal::CaptureStdout();
+  map.PrintTree();
+  std::string out = testing::internal::GetCapturedStdout();
+  // One line per element; the leaves and End() print nothing.
+  EXPECT_EQ(std::count(out.begin(), out.end(), '\n'), 3);
+  EXPECT_NE(out.find("L0:<2>,<20>"), std::string::npos);
+  EXPECT_NE(out.find("L1:<3>,<30>"), std::string::npos);
+}
+
 /////////////////////////////////////////////////////
 
 TEST(SetTest, DefaultConstructor) {
@@ -1287,7 +1448,7 @@ TEST(IterTest, IteratorIncrement) {
 
   auto it = tree.Find(123);
   ++it;
-  EXPECT_EQ(it.GetKey(), 0);
+  EXPECT_TRUE(it == tree.End());
 }
 
 TEST(ConstIterTest, DefaultConstructor) {
@@ -1489,6 +1650,1463 @@ TEST(NodeTest, MoveAssignmentOperator) {
   EXPECT_FALSE(original.end_);
 }
 
+TEST(NodePoolTest, ReusesFreedNodes) {
+  s21::NodePool<s21::Node<int, int>> pool;
+  s21::Node<int, int>* first = pool.Create();
+  first->key_ = 1;
+  pool.Destroy(first);
+  s21::Node<int, int>* second = pool.Create();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(second->key_, 0);
+  pool.Destroy(second);
+}
+
+TEST(NodePoolTest, Reserve) {
+  s21::NodePool<s21::Node<int, std::string>> pool;
+  EXPECT_EQ(pool.Available(), 0);
+  pool.Reserve(100);
+  EXPECT_GE(pool.Available(), 100);
+  std::vector<s21::Node<int, std::string>*> nodes;
+  for (int i = 0; i < 100; ++i) {
+    nodes.push_back(pool.Create());
+    nodes.back()->val_ = std::string(64, 'a');
+  }
+  for (auto* node : nodes) {
+    pool.Destroy(node);
+  }
+  EXPECT_GE(pool.Available(), 100);
+}
+
+TEST(NodePoolTest, RetainKeepsDonorMemory) {
+  s21::NodePool<s21::Node<int, std::string>> keeper;
+  s21::Node<int, std::string>* node = nullptr;
+  {
+    s21::NodePool<s21::Node<int, std::string>> donor;
+    node = donor.Create();
+    node->val_ = std::string(64, 'a');
+    keeper.Retain(donor);
+    keeper.Retain(donor);
+    donor.Destroy(donor.Create());
+  }
+  EXPECT_EQ(node->val_, std::string(64, 'a'));
+  keeper.Destroy(node);
+  EXPECT_EQ(keeper.Create(), node);
+  keeper.Destroy(node);
+}
+
+TEST(NodePoolTest, MapReserve) {
+  s21::Map<int, std::string> map;
+  map.Reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    map.Insert(i, std::to_string(i));
+  }
+  EXPECT_EQ(map.Size(), 1000);
+  EXPECT_EQ(map.At(500), "500");
+  for (int i = 0; i < 1000; i += 2) {
+    map.Erase(map.Find(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    map.Insert(i, "again");
+  }
+  EXPECT_EQ(map.Size(), 1000);
+  EXPECT_EQ(map.At(0), "again");
+  EXPECT_EQ(map.At(1), "1");
+}
+
+namespace {
+
+// Returns the black height of the subtree, or -1 if a red-black or ordering
+// invariant is broken somewhere below node. Equal keys next to each other
+// are only accepted when unique is false.
+template <typename Key, typename T, typename Augment>
+int BlackHeight(const s21::Node<Key, T, Augment>* node, bool unique = true) {
+  if (node == nullptr || node->end_) {
+    return 1;
+  }
+  for (const s21::Node<Key, T, Augment>* child : {node->left_, node->right_}) {
+    if (child->end_) continue;
+    if (child->parent_ != node) return -1;
+    if (node->color_ == RED && child->color_ == RED) return -1;
+  }
+  if (!node->left_->end_ && (unique ? !(node->left_->key_ < node->key_)
+                                    : node->key_ < node->left_->key_)) {
+    return -1;
+  }
+  if (!node->right_->end_ && (unique ? !(node->key_ < node->right_->key_)
+                                     : node->right_->key_ < node->key_)) {
+    return -1;
+  }
+  int left = BlackHeight(node->left_, unique);
+  int right = BlackHeight(node->right_, unique);
+  if (left < 0 || left != right) return -1;
+  return left + (node->color_ == BLACK ? 1 : 0);
+}
+
+}  // namespace
+
+TEST(BuildFromSortedTest, ValidTreeForEverySize) {
+  for (int n = 0; n <= 200; ++n) {
+    std::vector<std::pair<int, int>> items;
+    for (int i = 0; i < n; ++i) {
+      items.emplace_back(i, i * 10);
+    }
+    s21::Map<int, int> map(items.begin(), items.end());
+    ASSERT_EQ(map.Size(), static_cast<std::size_t>(n));
+    ASSERT_GT(BlackHeight(map.GetRoot()), 0);
+    if (n > 0) {
+      EXPECT_EQ(map.GetRoot()->color_, BLACK);
+      EXPECT_EQ(map.Begin().GetKey(), 0);
+    }
+    int expected = 0;
+    for (auto it = map.Begin(); it != map.End(); ++it) {
+      ASSERT_EQ(it.GetKey(), expected);
+      ASSERT_EQ(it.GetVal(), expected * 10);
+      ++expected;
+    }
+    ASSERT_EQ(expected, n);
+  }
+}
+
+TEST(BuildFromSortedTest, ReplacesContentsAndStaysUsable) {
+  s21::Set<int> set = {100, 200};
+  std::vector<int> keys = {1, 3, 5, 7, 9, 11, 13};
+  set.BuildFromSorted(keys.begin(), keys.end());
+  EXPECT_EQ(set.Size(), 7);
+  EXPECT_FALSE(set.Contains(100));
+  EXPECT_TRUE(set.Contains(13));
+  for (int key = 0; key < 20; key += 2) {
+    set.Insert(key);
+  }
+  set.Erase(set.Find(7));
+  EXPECT_EQ(set.Size(), 16);
+  EXPECT_GT(BlackHeight(set.GetRoot()), 0);
+}
+
+TEST(BuildFromSortedTest, UnsortedInputFallsBackToInsert) {
+  std::vector<int> keys = {5, 1, 4, 1, 3};
+  s21::Set<int> set(keys.begin(), keys.end());
+  EXPECT_EQ(set.Size(), 4);
+  EXPECT_EQ(set.Begin().GetKey(), 1);
+  EXPECT_GT(BlackHeight(set.GetRoot()), 0);
+}
+
+TEST(BuildFromSortedTest, CopyIsBalanced) {
+  s21::Map<int, std::string> original;
+  for (int i = 0; i < 1000; ++i) {
+    original.Insert(i, std::to_string(i));
+  }
+  s21::Map<int, std::string> copy(original);
+  EXPECT_EQ(copy.Size(), original.Size());
+  EXPECT_GT(BlackHeight(copy.GetRoot()), 0);
+  EXPECT_EQ(copy.At(999), "999");
+  auto last = copy.End();
+  --last;
+  EXPECT_EQ(last.GetKey(), 999);
+  copy.Erase(copy.Find(0));
+  EXPECT_EQ(copy.Begin().GetKey(), 1);
+  EXPECT_EQ(original.Begin().GetKey(), 0);
+}
+
+namespace {
+
+// True when both trees have the same shape, keys and colors.
+template <typename Key, typename T, typename Augment>
+bool SameShape(const s21::Node<Key, T, Augment>* a,
+               const s21::Node<Key, T, Augment>* b) {
+  if (a == nullptr || b == nullptr) return a == b;
+  if (a->end_ || b->end_) return a->end_ == b->end_;
+  return a->key_ == b->key_ && a->color_ == b->color_ &&
+         SameShape(a->left_, b->left_) && SameShape(a->right_, b->right_);
+}
+
+}  // namespace
+
+TEST(CloneTest, CopyKeepsShapeAndColors) {
+  std::mt19937 gen(7);
+  s21::Map<int, std::string> original;
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 100000);
+    original.Insert(key, std::to_string(key));
+  }
+  s21::Map<int, std::string> copy(original);
+  EXPECT_TRUE(SameShape(copy.GetRoot(), original.GetRoot()));
+  EXPECT_GT(BlackHeight(copy.GetRoot()), 0);
+  auto last = copy.End();
+  --last;
+  auto original_last = original.End();
+  --original_last;
+  EXPECT_EQ(last.GetVal(), original_last.GetVal());
+  copy.Insert(-1, "new");
+  EXPECT_EQ(copy.Begin().GetKey(), -1);
+  EXPECT_FALSE(original.Contains(-1));
+
+  s21::Map<int, std::string> empty;
+  copy = empty;
+  EXPECT_TRUE(copy.Empty());
+  EXPECT_EQ(copy.Begin(), copy.End());
+}
+
+TEST(CloneTest, CopyAssignKeepsAugmentData) {
+  using RankedSet =
+      s21::Set<int, std::less<int>, std::allocator<int>, s21::OrderStatistic>;
+  RankedSet source;
+  RankedSet target;
+  for (int i = 0; i < 1000; ++i) {
+    source.Insert(i * 2);
+    target.Insert(i * 3);
+  }
+  target = source;
+  EXPECT_TRUE(SameShape(target.GetRoot(), source.GetRoot()));
+  // The subtree sizes come along with the nodes.
+  EXPECT_EQ(target.Rank(1000), 500u);
+  EXPECT_EQ(target.Select(999).GetKey(), 1998);
+  target.Erase(target.Find(0));
+  EXPECT_EQ(target.Select(0).GetKey(), 2);
+  EXPECT_EQ(source.Size(), 1000u);
+}
+
+namespace {
+
+// Checks the tree invariants and that iteration in both directions visits
+// exactly the keys of expected.
+template <typename SetType>
+void ExpectSameKeys(SetType& set, const std::set<int>& expected) {
+  ASSERT_EQ(set.Size(), expected.size());
+  ASSERT_GT(BlackHeight(set.GetRoot()), 0);
+  auto want = expected.begin();
+  for (auto it = set.Begin(); it != set.End(); ++it, ++want) {
+    ASSERT_EQ(it.GetKey(), *want);
+  }
+  if (!expected.empty()) {
+    auto last = set.End();
+    --last;
+    EXPECT_EQ(last.GetKey(), *expected.rbegin());
+  }
+}
+
+std::set<int> RandomKeys(std::size_t count, int range, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, range);
+  std::set<int> keys;
+  while (keys.size() < count) {
+    keys.insert(dist(gen));
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(SetAlgebraTest, RandomInsertErase) {
+  s21::Set<int> set;
+  std::set<int> expected;
+  std::mt19937 gen(7);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    if (gen() % 3 == 0) {
+      if (set.Contains(key)) set.Erase(set.Find(key));
+      expected.erase(key);
+    } else {
+      set.Insert(key);
+      expected.insert(key);
+    }
+  }
+  ExpectSameKeys(set, expected);
+}
+
+TEST(SetAlgebraTest, SplitAndJoin) {
+  std::set<int> keys = RandomKeys(5000, 100000, 1);
+  for (int pivot : {-1, 0, 31337, 50000, *keys.begin(), *keys.rbegin(),
+                    100001}) {
+    s21::Set<int> left(keys.begin(), keys.end());
+    s21::Set<int> right = {1, 2, 3};
+    left.Split(pivot, right);
+    std::set<int> below(keys.begin(), keys.lower_bound(pivot));
+    std::set<int> above(keys.lower_bound(pivot), keys.end());
+    ExpectSameKeys(left, below);
+    ExpectSameKeys(right, above);
+    left.Join(right);
+    EXPECT_TRUE(right.Empty());
+    ExpectSameKeys(left, keys);
+    left.Insert(-5);
+    left.Erase(left.Find(*keys.rbegin()));
+    EXPECT_EQ(left.Begin().GetKey(), -5);
+  }
+}
+
+TEST(SetAlgebraTest, JoinOverlappingFallsBackToMerge) {
+  s21::Map<int, char> left = {{1, 'a'}, {5, 'b'}};
+  s21::Map<int, char> right = {{5, 'x'}, {7, 'c'}};
+  left.Join(right);
+  EXPECT_EQ(left.Size(), 3);
+  EXPECT_EQ(left.At(5), 'b');
+  EXPECT_EQ(right.Size(), 1);
+}
+
+TEST(SetAlgebraTest, SplitSourceOutlivedByParts) {
+  s21::Map<int, std::string> right;
+  {
+    s21::Map<int, std::string> source;
+    for (int i = 0; i < 1000; ++i) {
+      source.Insert(i, std::to_string(i));
+    }
+    source.Split(400, right);
+    EXPECT_EQ(source.Size(), 400);
+  }
+  EXPECT_EQ(right.Size(), 600);
+  EXPECT_EQ(right.At(999), "999");
+  right.Erase(right.Find(400));
+  EXPECT_EQ(right.Begin().GetKey(), 401);
+}
+
+TEST(SetAlgebraTest, UnionIntersectionDifference) {
+  for (std::size_t size : {0, 1, 10, 1000, 200000}) {
+    std::set<int> a_keys = RandomKeys(size, 400000, 2);
+    std::set<int> b_keys = RandomKeys(size / 2 + 3, 400000, 3);
+    std::set<int> both;
+    std::set<int> only_a;
+    std::set<int> either = a_keys;
+    either.insert(b_keys.begin(), b_keys.end());
+    for (int key : a_keys) {
+      (b_keys.count(key) ? both : only_a).insert(key);
+    }
+    s21::Set<int> a(a_keys.begin(), a_keys.end());
+    s21::Set<int> b(b_keys.begin(), b_keys.end());
+
+    s21::Set<int> intersection(a);
+    intersection.Intersection(b);
+    ExpectSameKeys(intersection, both);
+
+    s21::Set<int> difference(a);
+    difference.Difference(b);
+    ExpectSameKeys(difference, only_a);
+
+    a.Union(b);
+    EXPECT_TRUE(b.Empty());
+    ExpectSameKeys(a, either);
+  }
+}
+
+TEST(SetAlgebraTest, MapUnionKeepsOwnValues) {
+  s21::Map<int, std::string> base = {{1, "base"}, {2, "base"}};
+  s21::Map<int, std::string> extra = {{2, "extra"}, {3, "extra"}};
+  base.Union(extra);
+  EXPECT_EQ(base.Size(), 3);
+  EXPECT_EQ(base.At(2), "base");
+  EXPECT_EQ(base.At(3), "extra");
+  base.Intersection(s21::Map<int, std::string>{{3, ""}, {4, ""}});
+  EXPECT_EQ(base.Size(), 1);
+  EXPECT_EQ(base.At(3), "extra");
+  base.Difference(base);
+  EXPECT_TRUE(base.Empty());
+}
+
+namespace {
+
+struct CaseInsensitiveLess {
+  bool operator()(const std::string& a, const std::string& b) const {
+    return std::lexicographical_compare(
+        a.begin(), a.end(), b.begin(), b.end(),
+        [](char x, char y) { return std::tolower(x) < std::tolower(y); });
+  }
+};
+
+struct CountingLess {
+  bool operator()(int a, int b) const {
+    ++*calls_;
+    return a < b;
+  }
+  int* calls_;
+};
+
+}  // namespace
+
+TEST(CompareTest, ReverseOrder) {
+  s21::Set<int, std::greater<int>> set = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::vector<int> keys;
+  for (auto it = set.Begin(); it != set.End(); ++it) {
+    keys.push_back(it.GetKey());
+  }
+  EXPECT_EQ(keys, (std::vector<int>{9, 6, 5, 4, 3, 2, 1}));
+  EXPECT_TRUE(set.Contains(4));
+  EXPECT_FALSE(set.Contains(7));
+  set.Erase(set.Find(9));
+  EXPECT_EQ(set.Begin().GetKey(), 6);
+
+  s21::Set<int, std::greater<int>> low;
+  set.Split(3, low);
+  EXPECT_EQ(set.Size(), 3);
+  EXPECT_EQ(low.Begin().GetKey(), 3);
+  set.Join(low);
+  EXPECT_EQ(set.Size(), 6);
+}
+
+TEST(CompareTest, CustomOrderingMap) {
+  s21::Map<std::string, int, CaseInsensitiveLess> map;
+  EXPECT_TRUE(map.Insert("Key", 1).second);
+  EXPECT_FALSE(map.Insert("KEY", 2).second);
+  map["apple"] = 3;
+  EXPECT_EQ(map.At("kEy"), 1);
+  EXPECT_EQ(map.Begin().GetKey(), "apple");
+  EXPECT_EQ(map.Size(), 2);
+}
+
+TEST(CompareTest, OneComparisonPerLevel) {
+  int calls = 0;
+  std::vector<int> items;
+  for (int i = 0; i < 1023; ++i) {
+    items.push_back(i);
+  }
+  // A perfect tree of 1023 keys: every lookup walks exactly ten levels.
+  s21::Set<int, CountingLess> set(items.begin(), items.end(),
+                                  CountingLess{&calls});
+  for (int key : items) {
+    calls = 0;
+    ASSERT_TRUE(set.Contains(key));
+    EXPECT_EQ(calls, 11);
+  }
+  calls = 0;
+  // Larger than every key, so there is no candidate to test for equality.
+  set.Insert(2000);
+  EXPECT_EQ(calls, 10);
+  s21::Set<int, CountingLess> copy(set);
+  calls = 0;
+  EXPECT_TRUE(copy.Contains(2000));
+  EXPECT_GT(calls, 0);
+}
+
+namespace {
+
+struct Employee {
+  int id_;
+  std::string name_;
+};
+
+// Orders employees by id and lets them be looked up by a bare id.
+struct ById {
+  using is_transparent = void;
+  bool operator()(const Employee& a, const Employee& b) const {
+    return a.id_ < b.id_;
+  }
+  bool operator()(const Employee& a, int id) const { return a.id_ < id; }
+  bool operator()(int id, const Employee& a) const { return id < a.id_; }
+};
+
+}  // namespace
+
+TEST(HeterogeneousLookupTest, StringMapWithoutTemporaryKeys) {
+  s21::Map<std::string, int, std::less<>> map = {
+      {"alpha", 1}, {"beta", 2}, {"delta", 4}};
+  // std::string cannot be built implicitly from a string_view, so these
+  // calls only compile through the transparent overloads.
+  std::string_view beta = "beta";
+  EXPECT_EQ(map.Find(beta).GetVal(), 2);
+  EXPECT_TRUE(map.Contains(std::string_view("alpha")));
+  EXPECT_EQ(map.Count(std::string_view("gamma")), 0);
+  EXPECT_EQ(map.LowerBound(std::string_view("charlie")).GetKey(), "delta");
+  EXPECT_EQ(map.LowerBound(std::string_view("omega")), map.End());
+  EXPECT_EQ(map.Find("delta").GetVal(), 4);
+  EXPECT_EQ(map.Find(std::string("alpha")).GetVal(), 1);
+}
+
+TEST(HeterogeneousLookupTest, LookupByMember) {
+  s21::Set<Employee, ById> staff;
+  staff.Insert(Employee{30, "Carol"});
+  staff.Insert(Employee{10, "Alice"});
+  staff.Insert(Employee{20, "Bob"});
+  EXPECT_EQ(staff.Find(20).GetKey().name_, "Bob");
+  EXPECT_TRUE(staff.Contains(10));
+  EXPECT_FALSE(staff.Contains(15));
+  EXPECT_EQ(staff.Count(30), 1);
+  EXPECT_EQ(staff.LowerBound(15).GetKey().id_, 20);
+  EXPECT_EQ(staff.LowerBound(31), staff.End());
+}
+
+TEST(HeterogeneousLookupTest, LowerBoundWithPlainKey) {
+  s21::Set<int> set = {10, 20, 30};
+  EXPECT_EQ(set.LowerBound(5).GetKey(), 10);
+  EXPECT_EQ(set.LowerBound(20).GetKey(), 20);
+  EXPECT_EQ(set.LowerBound(21).GetKey(), 30);
+  EXPECT_EQ(set.LowerBound(31), set.End());
+  EXPECT_EQ(set.Count(20), 1);
+  EXPECT_EQ(set.Count(25), 0);
+  s21::Set<int> empty;
+  EXPECT_EQ(empty.LowerBound(1), empty.End());
+}
+
+namespace {
+
+// Counts how often it is copied or moved.
+struct Tracked {
+  Tracked() = default;
+  explicit Tracked(int value) : value_(value) {}
+  Tracked(const Tracked& other) : value_(other.value_) { ++copies_; }
+  Tracked(Tracked&& other) noexcept : value_(other.value_) { ++moves_; }
+  Tracked& operator=(const Tracked& other) {
+    value_ = other.value_;
+    ++copies_;
+    return *this;
+  }
+  Tracked& operator=(Tracked&& other) noexcept {
+    value_ = other.value_;
+    ++moves_;
+    return *this;
+  }
+
+  static void Reset() {
+    copies_ = 0;
+    moves_ = 0;
+  }
+
+  int value_ = 0;
+  static int copies_;
+  static int moves_;
+};
+
+int Tracked::copies_ = 0;
+int Tracked::moves_ = 0;
+
+}  // namespace
+
+TEST(EmplaceTest, ConstructsValueInPlace) {
+  s21::Map<int, Tracked> map;
+  Tracked::Reset();
+  EXPECT_TRUE(map.Emplace(1, 10).second);
+  EXPECT_TRUE(map.TryEmplace(2, 20).second);
+  EXPECT_TRUE(map.Emplace(std::piecewise_construct, std::forward_as_tuple(3),
+                          std::forward_as_tuple(30))
+                  .second);
+  EXPECT_EQ(Tracked::copies_, 0);
+  EXPECT_EQ(Tracked::moves_, 0);
+
+  EXPECT_FALSE(map.Emplace(1, 11).second);
+  EXPECT_FALSE(map.TryEmplace(2, 21).second);
+  EXPECT_EQ(map.At(1).value_, 10);
+  EXPECT_EQ(map.At(2).value_, 20);
+  EXPECT_EQ(map.At(3).value_, 30);
+
+  std::pair<const int, Tracked> value(4, Tracked(40));
+  Tracked::Reset();
+  EXPECT_TRUE(map.Insert(std::move(value)).second);
+  EXPECT_EQ(Tracked::copies_, 0);
+  EXPECT_EQ(Tracked::moves_, 1);
+
+  Tracked::Reset();
+  map.Insert(5, Tracked(50));
+  EXPECT_EQ(Tracked::copies_, 1);
+  EXPECT_EQ(Tracked::moves_, 0);
+}
+
+TEST(EmplaceTest, MoveOnlyValues) {
+  s21::Map<std::string, std::unique_ptr<int>> map;
+  map.Emplace("a", std::make_unique<int>(1));
+  map.Insert({"b", std::make_unique<int>(2)});
+  auto spare = std::make_unique<int>(3);
+  EXPECT_FALSE(map.TryEmplace("a", std::move(spare)).second);
+  ASSERT_NE(spare, nullptr);
+  EXPECT_TRUE(map.TryEmplace("c", std::move(spare)).second);
+  EXPECT_EQ(spare, nullptr);
+
+  auto result = map.InsertOrAssign("a", std::make_unique<int>(11));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*result.first.GetVal(), 11);
+  std::string key = "d";
+  result = map.InsertOrAssign(std::move(key), std::make_unique<int>(4));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(map.Size(), 4);
+  EXPECT_EQ(*map.At("b"), 2);
+  EXPECT_EQ(*map.At("c"), 3);
+  EXPECT_EQ(*map.At("d"), 4);
+
+  s21::Map<std::string, std::unique_ptr<int>> moved(std::move(map));
+  EXPECT_EQ(*moved.At("a"), 11);
+}
+
+TEST(EmplaceTest, SetEmplaceAndMoveInsert) {
+  s21::Set<std::string> set;
+  EXPECT_TRUE(set.Emplace(3, 'x').second);
+  EXPECT_TRUE(set.Contains("xxx"));
+  std::string key(100, 'k');
+  EXPECT_TRUE(set.Insert(std::move(key)).second);
+  EXPECT_TRUE(key.empty());
+  std::string again(100, 'k');
+  EXPECT_FALSE(set.Emplace(again).second);
+  EXPECT_FALSE(set.Insert(std::move(again)).second);
+  EXPECT_EQ(again.size(), 100);
+  EXPECT_EQ(set.Size(), 2);
+}
+
+TEST(EmplaceTest, SubscriptAndInsertOrAssignDescendOnce) {
+  int calls = 0;
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1023; ++i) {
+    items.emplace_back(i, 0);
+  }
+  s21::Map<int, int, CountingLess> map(items.begin(), items.end(),
+                                       CountingLess{&calls});
+  calls = 0;
+  map[500]++;
+  EXPECT_EQ(calls, 11);
+  calls = 0;
+  map[-1] += 7;
+  EXPECT_EQ(calls, 11);
+  calls = 0;
+  EXPECT_TRUE(map.insert_or_assign(500, 5).second);
+  EXPECT_EQ(calls, 11);
+  EXPECT_EQ(map.At(500), 5);
+  EXPECT_EQ(map.At(-1), 7);
+  EXPECT_EQ(map.Size(), 1024);
+
+  s21::Map<std::string, int> counts;
+  for (const char* word : {"a", "b", "a", "c", "a"}) {
+    ++counts[word];
+  }
+  std::string key = "b";
+  counts[std::move(key)] += 10;
+  EXPECT_EQ(counts.At("a"), 3);
+  EXPECT_EQ(counts.At("b"), 11);
+  EXPECT_EQ(counts.Size(), 3);
+}
+
+TEST(HintTest, SortedAppendsCompareOnce) {
+  int calls = 0;
+  s21::Set<int, CountingLess> set(CountingLess{&calls});
+  std::set<int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    set.Insert(set.End(), i);
+    expected.insert(i);
+  }
+  EXPECT_EQ(calls, 4999);
+  ExpectSameKeys(set, expected);
+
+  calls = 0;
+  auto hint = set.Begin();
+  for (int i = -1; i >= -5000; --i) {
+    hint = set.EmplaceHint(hint, i);
+    expected.insert(i);
+  }
+  EXPECT_EQ(calls, 5000);
+  ExpectSameKeys(set, expected);
+}
+
+TEST(HintTest, AnyHintKeepsTreeValid) {
+  s21::Set<int> set;
+  std::set<int> expected;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    auto hint = set.End();
+    if (!set.Empty() && gen() % 4 != 0) {
+      hint = set.LowerBound(static_cast<int>(gen() % 5000));
+    }
+    auto it = set.Insert(hint, key);
+    EXPECT_EQ(it.GetKey(), key);
+    expected.insert(key);
+  }
+  ExpectSameKeys(set, expected);
+}
+
+TEST(HintTest, MapHintedInsert) {
+  s21::Map<int, std::string> map = {{10, "ten"}, {30, "thirty"}};
+  auto it = map.Insert(map.Find(30), {20, "twenty"});
+  EXPECT_EQ(it.GetVal(), "twenty");
+  it = map.Insert(map.Find(10), std::make_pair(20, std::string("again")));
+  EXPECT_EQ(it.GetVal(), "twenty");
+  it = map.EmplaceHint(map.End(), 40, "forty");
+  EXPECT_EQ(it.GetKey(), 40);
+  it = map.EmplaceHint(map.Begin(), std::piecewise_construct,
+                       std::forward_as_tuple(5), std::forward_as_tuple(3, 'x'));
+  EXPECT_EQ(it.GetVal(), "xxx");
+  EXPECT_EQ(map.Size(), 5);
+  EXPECT_EQ(map.Begin().GetKey(), 5);
+  auto last = map.End();
+  --last;
+  EXPECT_EQ(last.GetKey(), 40);
+}
+
+TEST(RangeTest, Bounds) {
+  s21::Set<int> set{10, 20, 30, 40};
+  EXPECT_EQ(set.LowerBound(20).GetKey(), 20);
+  EXPECT_EQ(set.UpperBound(20).GetKey(), 30);
+  EXPECT_EQ(set.UpperBound(25).GetKey(), 30);
+  EXPECT_EQ(set.UpperBound(5).GetKey(), 10);
+  EXPECT_EQ(set.UpperBound(40), set.End());
+
+  auto hit = set.EqualRange(30);
+  EXPECT_EQ(hit.first.GetKey(), 30);
+  EXPECT_EQ(hit.second.GetKey(), 40);
+  auto miss = set.EqualRange(35);
+  EXPECT_EQ(miss.first, miss.second);
+  EXPECT_EQ(miss.first.GetKey(), 40);
+  auto past = set.EqualRange(50);
+  EXPECT_EQ(past.first, set.End());
+  EXPECT_EQ(past.second, set.End());
+
+  s21::Map<std::string, int, std::less<>> map{{"a", 1}, {"c", 3}, {"e", 5}};
+  std::string_view key = "c";
+  EXPECT_EQ(map.UpperBound(key).GetKey(), "e");
+  auto range = map.EqualRange(key);
+  EXPECT_EQ(range.first.GetVal(), 3);
+  EXPECT_EQ(range.second.GetVal(), 5);
+}
+
+TEST(RangeTest, WindowScan) {
+  s21::Map<int, int> events;
+  for (int t = 0; t < 1000; t += 5) {
+    events.Insert(t, t / 5);
+  }
+  std::vector<int> window;
+  for (auto it = events.LowerBound(102), end = events.LowerBound(130);
+       it != end; ++it) {
+    window.push_back(it.GetKey());
+  }
+  EXPECT_EQ(window, (std::vector<int>{105, 110, 115, 120, 125}));
+}
+
+TEST(RangeTest, EraseRange) {
+  std::mt19937 gen(5);
+  for (int round = 0; round < 200; ++round) {
+    std::set<int> expected = RandomKeys(gen() % 300, 1000, round);
+    s21::Set<int> set;
+    for (int key : expected) {
+      set.Insert(key);
+    }
+    int a = static_cast<int>(gen() % 1100);
+    int b = a + static_cast<int>(gen() % 400);
+    set.Erase(set.LowerBound(a), set.LowerBound(b));
+    expected.erase(expected.lower_bound(a), expected.lower_bound(b));
+    ExpectSameKeys(set, expected);
+  }
+
+  s21::Map<int, std::string> map{{1, "a"}, {2, "b"}, {3, "c"}};
+  map.Erase(map.Find(2), map.Find(2));
+  EXPECT_EQ(map.Size(), 3);
+  map.Erase(map.Begin(), map.End());
+  EXPECT_TRUE(map.Empty());
+  map.Insert(4, "d");
+  EXPECT_EQ(map.Begin().GetVal(), "d");
+}
+
+// Returns the number of nodes below node, or -1 if a stored subtree size is
+// wrong somewhere.
+template <typename Key, typename T>
+long CountedSize(const s21::Node<Key, T, s21::OrderStatistic>* node) {
+  if (node == nullptr || node->end_) {
+    return node == nullptr || node->size_ == 0 ? 0 : -1;
+  }
+  long left = CountedSize(node->left_);
+  long right = CountedSize(node->right_);
+  if (left < 0 || right < 0) return -1;
+  long size = left + right + 1;
+  return static_cast<long>(node->size_) == size ? size : -1;
+}
+
+using RankedSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                           s21::OrderStatistic>;
+
+void ExpectRanks(RankedSet& set, const std::set<int>& expected) {
+  ExpectSameKeys(set, expected);
+  ASSERT_EQ(CountedSize(set.GetRoot()), static_cast<long>(expected.size()));
+  std::size_t index = 0;
+  for (int key : expected) {
+    ASSERT_EQ(set.Rank(key), index);
+    ASSERT_EQ(set.Select(index).GetKey(), key);
+    ++index;
+  }
+  EXPECT_EQ(set.Select(index), set.End());
+}
+
+TEST(OrderStatisticTest, RankSelectAdvance) {
+  EXPECT_TRUE(std::is_empty_v<s21::NoAugment>);
+  EXPECT_EQ(sizeof(s21::Node<int, int, s21::OrderStatistic>),
+            sizeof(s21::Node<int, int>) + sizeof(std::size_t));
+
+  RankedSet set{50, 10, 40, 20, 30};
+  EXPECT_EQ(set.Rank(10), 0u);
+  EXPECT_EQ(set.Rank(35), 3u);
+  EXPECT_EQ(set.Rank(99), 5u);
+  EXPECT_EQ(set.Select(2).GetKey(), 30);
+  EXPECT_EQ(set.Select(5), set.End());
+
+  auto it = set.Advance(set.Begin(), 3);
+  EXPECT_EQ(it.GetKey(), 40);
+  EXPECT_EQ(set.Advance(it, -2).GetKey(), 20);
+  EXPECT_EQ(set.Advance(it, 1).GetKey(), 50);
+  EXPECT_EQ(set.Advance(it, 2), set.End());
+  EXPECT_EQ(set.Advance(it, -4), set.End());
+  EXPECT_EQ(set.Advance(set.End(), -5).GetKey(), 10);
+
+  s21::Map<double, int, std::less<double>,
+           std::allocator<std::pair<const double, int>>, s21::OrderStatistic>
+      latencies;
+  for (int i = 1; i <= 100; ++i) {
+    latencies.Insert(i * 1.5, i);
+  }
+  EXPECT_EQ(latencies.Select(latencies.Size() * 99 / 100).GetVal(), 100);
+  EXPECT_EQ(latencies.Rank(75.0), 49u);
+}
+
+TEST(OrderStatisticTest, SizesSurviveEveryUpdate) {
+  std::mt19937 gen(17);
+  RankedSet set;
+  std::set<int> expected;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    if (gen() % 3 == 0) {
+      if (set.Contains(key)) set.Erase(set.Find(key));
+      expected.erase(key);
+    } else {
+      set.Insert(set.LowerBound(key), key);
+      expected.insert(key);
+    }
+  }
+  ExpectRanks(set, expected);
+
+  set.Erase(set.LowerBound(200), set.LowerBound(300));
+  expected.erase(expected.lower_bound(200), expected.lower_bound(300));
+  auto node = set.Extract(set.Select(10));
+  expected.erase(node.GetKey());
+  node.GetKey() = 250;
+  set.Insert(std::move(node));
+  expected.insert(250);
+  ExpectRanks(set, expected);
+
+  RankedSet right;
+  set.Split(500, right);
+  ExpectRanks(right, {expected.lower_bound(500), expected.end()});
+  set.Join(right);
+  ExpectRanks(set, expected);
+
+  std::set<int> other_keys = RandomKeys(500, 2000, 3);
+  RankedSet other(other_keys.begin(), other_keys.end());
+  ExpectRanks(other, other_keys);
+  RankedSet copy(set);
+  RankedSet consumed(other);
+  copy.Union(consumed);
+  EXPECT_TRUE(consumed.Empty());
+  std::set<int> united = expected;
+  united.insert(other_keys.begin(), other_keys.end());
+  ExpectRanks(copy, united);
+  copy = set;
+  copy.Intersection(other);
+  std::set<int> common;
+  std::set_intersection(expected.begin(), expected.end(), other_keys.begin(),
+                        other_keys.end(), std::inserter(common, common.end()));
+  ExpectRanks(copy, common);
+  set.Difference(other);
+  for (int key : other_keys) expected.erase(key);
+  ExpectRanks(set, expected);
+  set.Merge(other);
+  expected.insert(other_keys.begin(), other_keys.end());
+  ExpectRanks(set, expected);
+}
+
+template <typename Monoid>
+using AggregateMap = s21::Map<int, long, std::less<int>,
+                              std::allocator<std::pair<const int, long>>,
+                              s21::RangeAggregate<Monoid>>;
+
+template <typename Monoid>
+long Fold(const std::map<int, long>& values, int lo, int hi) {
+  long result = Monoid::Identity();
+  for (auto it = values.lower_bound(lo); it != values.end() && it->first <= hi;
+       ++it) {
+    result = Monoid::Combine(result, it->second);
+  }
+  return result;
+}
+
+TEST(AggregateTest, SumMinMax) {
+  AggregateMap<s21::SumMonoid<long>> sums = {{1, 10}, {4, 40}, {7, 70}};
+  EXPECT_EQ(sums.Aggregate(1, 7), 120);
+  EXPECT_EQ(sums.Aggregate(2, 6), 40);
+  EXPECT_EQ(sums.Aggregate(5, 6), 0);
+  EXPECT_EQ(sums.Aggregate(8, 2), 0);
+  sums.InsertOrAssign(4, 5);
+  EXPECT_EQ(sums.Aggregate(0, 100), 85);
+  sums[7] = 1;
+  sums.Refresh(sums.Find(7));
+  EXPECT_EQ(sums.Aggregate(0, 100), 16);
+  EXPECT_EQ(AggregateMap<s21::SumMonoid<long>>().Aggregate(0, 1), 0);
+
+  AggregateMap<s21::MinMonoid<long>> mins = {{1, 3}, {2, -8}, {3, 5}};
+  EXPECT_EQ(mins.Aggregate(1, 3), -8);
+  EXPECT_EQ(mins.Aggregate(3, 9), 5);
+  EXPECT_EQ(mins.Aggregate(4, 9), std::numeric_limits<long>::max());
+  s21::Map<int, double, std::less<int>,
+           std::allocator<std::pair<const int, double>>,
+           s21::RangeAggregate<s21::MaxMonoid<double>>>
+      peaks = {{0, 0.5}, {3, 2.5}, {1, 1.5}};
+  EXPECT_EQ(peaks.Aggregate(0, 2), 1.5);
+  EXPECT_EQ(peaks.Aggregate(4, 9), -std::numeric_limits<double>::infinity());
+}
+
+TEST(AggregateTest, RandomRanges) {
+  std::mt19937 gen(16);
+  AggregateMap<s21::SumMonoid<long>> sums;
+  AggregateMap<s21::MaxMonoid<long>> maxes;
+  std::map<int, long> values;
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(gen() % 1500);
+    long value = static_cast<long>(gen() % 1000) - 500;
+    if (gen() % 4 == 0) {
+      if (sums.Contains(key)) sums.Erase(sums.Find(key));
+      if (maxes.Contains(key)) maxes.Erase(maxes.Find(key));
+      values.erase(key);
+    } else {
+      sums.InsertOrAssign(key, value);
+      maxes.insert_or_assign(key, value);
+      values[key] = value;
+    }
+  }
+  sums.Erase(sums.LowerBound(300), sums.LowerBound(400));
+  maxes.Erase(maxes.LowerBound(300), maxes.LowerBound(400));
+  values.erase(values.lower_bound(300), values.lower_bound(400));
+  AggregateMap<s21::SumMonoid<long>> upper;
+  sums.Split(1000, upper);
+  sums.Join(upper);
+  AggregateMap<s21::SumMonoid<long>> copy(sums);
+  for (int i = 0; i < 500; ++i) {
+    int lo = static_cast<int>(gen() % 1600) - 50;
+    int hi = lo + static_cast<int>(gen() % 400);
+    ASSERT_EQ(copy.Aggregate(lo, hi),
+              Fold<s21::SumMonoid<long>>(values, lo, hi));
+    ASSERT_EQ(maxes.Aggregate(lo, hi),
+              Fold<s21::MaxMonoid<long>>(values, lo, hi));
+  }
+}
+
+TEST(MultisetTest, KeepsDuplicates) {
+  s21::Multiset<int> set = {3, 1, 3, 2, 3};
+  EXPECT_EQ(set.Size(), 5u);
+  EXPECT_EQ(set.Count(3), 3u);
+  EXPECT_EQ(set.Count(4), 0u);
+  EXPECT_EQ(set.Insert(1).GetKey(), 1);
+  auto range = set.EqualRange(1);
+  EXPECT_EQ(range.first, set.Begin());
+  EXPECT_EQ(range.second, set.Find(2));
+  set.Erase(set.LowerBound(3), set.End());
+  EXPECT_EQ(set.Size(), 3u);
+  EXPECT_FALSE(set.Contains(3));
+  range = set.EqualRange(7);
+  EXPECT_EQ(range.first, set.End());
+  EXPECT_EQ(range.second, set.End());
+
+  std::vector<s21::Multiset<int>::iterator> added = set.InsertMany(5, 2, 9, 9);
+  ASSERT_EQ(added.size(), 4u);
+  EXPECT_EQ(added[1].GetKey(), 2);
+  EXPECT_EQ(set.Count(9), 2u);
+  std::vector<int> keys;
+  for (auto it = set.Begin(); it != set.End(); ++it) {
+    keys.push_back(it.GetKey());
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 1, 2, 2, 5, 9, 9}));
+
+  s21::Multiset<int, std::less<int>, std::allocator<int>, s21::OrderStatistic>
+      ranked = {4, 4, 4, 1, 8};
+  EXPECT_EQ(ranked.Rank(4), 1u);
+  EXPECT_EQ(ranked.Rank(5), 4u);
+  EXPECT_EQ(ranked.Select(3).GetKey(), 4);
+}
+
+TEST(MultimapTest, EqualKeysKeepInsertionOrder) {
+  s21::Multimap<std::string, int> events = {{"b", 1}, {"a", 2}, {"b", 3}};
+  events.Insert("b", 4);
+  events.Emplace("a", 5);
+  events.InsertMany(std::make_pair(std::string("c"), 6),
+                    std::make_pair(std::string("b"), 7));
+  std::vector<int> order;
+  for (auto range = events.EqualRange("b"); range.first != range.second;
+       ++range.first) {
+    order.push_back(range.first.GetVal());
+  }
+  EXPECT_EQ(order, std::vector<int>({1, 3, 4, 7}));
+  EXPECT_EQ(events.Find("a").GetVal(), 2);
+  EXPECT_EQ(events.Count("b"), 4u);
+
+  s21::Multimap<std::string, int> copy(events);
+  events.Erase(events.Find("b"));
+  EXPECT_EQ(events.Find("b").GetVal(), 3);
+  EXPECT_EQ(copy.Find("b").GetVal(), 1);
+  EXPECT_EQ(copy.Size(), 7u);
+}
+
+TEST(MultimapTest, MatchesStdMultimap) {
+  std::mt19937 gen(17);
+  s21::Multimap<int, int> map;
+  std::multimap<int, int> expected;
+  for (int i = 0; i < 6000; ++i) {
+    int key = static_cast<int>(gen() % 300);
+    if (gen() % 3 == 0) {
+      auto it = map.Find(key);
+      if (it != map.End()) map.Erase(it);
+      auto found = expected.find(key);
+      if (found != expected.end()) expected.erase(found);
+    } else if (gen() % 50 == 0) {
+      map.InsertMany(std::make_pair(key, i), std::make_pair(key + 1, i),
+                     std::make_pair(key, i + 1));
+      expected.insert({{key, i}, {key + 1, i}, {key, i + 1}});
+    } else {
+      map.Insert(key, i);
+      expected.insert({key, i});
+    }
+  }
+  map.Erase(map.LowerBound(100), map.UpperBound(120));
+  expected.erase(expected.lower_bound(100), expected.upper_bound(120));
+  ASSERT_EQ(map.Size(), expected.size());
+  EXPECT_GT(BlackHeight(map.GetRoot(), false), 0);
+  auto it = map.Begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(it.GetKey(), key);
+    ASSERT_EQ(it.GetVal(), value);
+    ++it;
+  }
+  for (int key = 0; key < 300; key += 7) {
+    EXPECT_EQ(map.Count(key), expected.count(key));
+  }
+}
+
+namespace {
+
+// True when every node but the root is at least half full and all leaves
+// sit at depth Height() - 1. Each node holds an element, so walking the
+// elements visits every node.
+template <typename Tree>
+bool BTreeIsBalanced(const Tree& tree) {
+  int leaf_depth = -1;
+  for (auto it = tree.Begin(); it != tree.End(); ++it) {
+    auto* node = it.GetNode();
+    if (node->parent_ != nullptr && node->count_ < Tree::kMinCount) {
+      return false;
+    }
+    int depth = 0;
+    for (auto* up = node; up->parent_ != nullptr; up = up->parent_) ++depth;
+    if (node->leaf_) {
+      if (leaf_depth == -1) leaf_depth = depth;
+      if (depth != leaf_depth) return false;
+    }
+  }
+  return leaf_depth + 1 == tree.Height();
+}
+
+template <typename T>
+void ExpectBTreeMatchesStdMap(unsigned seed) {
+  std::mt19937 gen(seed);
+  s21::BTreeMap<int, T> map;
+  std::map<int, T> expected;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    if (gen() % 3 == 0) {
+      auto it = map.Find(key);
+      if (it != map.End()) map.Erase(it);
+      expected.erase(key);
+    } else {
+      T value{};
+      value[0] = i;
+      map.Insert(key, value);
+      expected.insert({key, value});
+    }
+  }
+  map.Erase(map.LowerBound(500), map.UpperBound(700));
+  expected.erase(expected.lower_bound(500), expected.upper_bound(700));
+  ASSERT_EQ(map.Size(), expected.size());
+  EXPECT_TRUE(BTreeIsBalanced(map));
+  auto it = map.Begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(it.GetKey(), key);
+    ASSERT_EQ(it.GetVal()[0], value[0]);
+    ++it;
+  }
+  EXPECT_TRUE(it == map.End());
+  for (auto back = expected.rbegin(); back != expected.rend(); ++back) {
+    --it;
+    ASSERT_EQ(it.GetKey(), back->first);
+  }
+  EXPECT_TRUE(it == map.Begin());
+}
+
+}  // namespace
+
+TEST(BTreeTest, MatchesStdMap) {
+  ExpectBTreeMatchesStdMap<std::array<int, 1>>(23);
+}
+
+TEST(BTreeTest, SmallNodesMatchStdMap) {
+  // Large values leave room for only three elements per node, so the tree
+  // gets deep and every rotation and merge runs often.
+  static_assert(s21::BTreeMap<int, std::array<int, 16>>::kCapacity == 3);
+  ExpectBTreeMatchesStdMap<std::array<int, 16>>(29);
+}
+
+TEST(BTreeTest, StaysShallow) {
+  s21::BTreeSet<int> set;
+  for (int i = 0; i < 100000; ++i) {
+    set.Insert(i);
+  }
+  EXPECT_TRUE(BTreeIsBalanced(set));
+  EXPECT_LE(set.Height(), 4);
+  set.Erase(set.Find(100), set.Find(99000));
+  EXPECT_EQ(set.Size(), 1100u);
+  EXPECT_TRUE(BTreeIsBalanced(set));
+  EXPECT_EQ(set.LowerBound(100).GetKey(), 99000);
+  set.Erase(set.Begin(), set.End());
+  EXPECT_TRUE(set.Empty());
+  EXPECT_EQ(set.Height(), 0);
+  EXPECT_TRUE(set.Begin() == set.End());
+}
+
+TEST(BTreeTest, MapInterface) {
+  s21::BTreeMap<std::string, int> map{{"b", 2}, {"a", 1}, {"b", 3}};
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.At("b"), 2);
+  EXPECT_THROW(map.At("z"), std::out_of_range);
+  map["c"] = 4;
+  EXPECT_EQ(map.At("c"), 4);
+  EXPECT_TRUE(map.Emplace("d", 5).second);
+  EXPECT_FALSE(map.Emplace(std::string("d"), 6).second);
+  EXPECT_TRUE(map.Emplace(std::piecewise_construct,
+                          std::forward_as_tuple(3, 'e'),
+                          std::forward_as_tuple(7))
+                  .second);
+  EXPECT_EQ(map.At("eee"), 7);
+  EXPECT_FALSE(map.InsertOrAssign("a", 10).second);
+  EXPECT_EQ(map.At("a"), 10);
+  EXPECT_FALSE(map.insert_or_assign("a", 11).first == map.End());
+  EXPECT_EQ(map.Find("a").GetVal(), 11);
+  auto range = map.EqualRange("c");
+  EXPECT_EQ(range.first.GetKey(), "c");
+  EXPECT_EQ(range.second.GetKey(), "d");
+  EXPECT_EQ(map.Count("c"), 1u);
+  EXPECT_FALSE(map.Contains("cc"));
+  EXPECT_TRUE(map.UpperBound("eee") == map.End());
+}
+
+TEST(BTreeTest, CopyMoveAndMerge) {
+  s21::BTreeMap<int, std::string> original;
+  for (int i = 0; i < 1000; ++i) {
+    original.Insert(i, std::to_string(i));
+  }
+  s21::BTreeMap<int, std::string> copy(original);
+  EXPECT_EQ(copy.Height(), original.Height());
+  EXPECT_TRUE(BTreeIsBalanced(copy));
+  copy.Erase(copy.Find(0));
+  EXPECT_EQ(original.Begin().GetVal(), "0");
+  auto last = copy.End();
+  --last;
+  EXPECT_EQ(last.GetVal(), "999");
+
+  s21::BTreeMap<int, std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.Empty());
+  EXPECT_EQ(moved.Size(), 999u);
+  copy = moved;
+  EXPECT_EQ(copy.Size(), 999u);
+
+  s21::BTreeMap<int, std::string> other;
+  other.Insert(0, "zero");
+  other.Insert(5, "five");
+  other.Insert(2000, "two thousand");
+  moved.Merge(other);
+  EXPECT_EQ(moved.Size(), 1001u);
+  EXPECT_EQ(moved.At(0), "zero");
+  EXPECT_EQ(moved.At(5), "5");
+  ASSERT_EQ(other.Size(), 1u);
+  EXPECT_EQ(other.Begin().GetVal(), "five");
+  EXPECT_TRUE(BTreeIsBalanced(moved));
+}
+
+TEST(FlatTest, MatchesStdMap) {
+  std::mt19937 gen(31);
+  s21::FlatMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 6000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    if (gen() % 3 == 0) {
+      auto it = map.Find(key);
+      if (it != map.End()) map.Erase(it);
+      expected.erase(key);
+    } else if (gen() % 10 == 0) {
+      std::vector<std::pair<const int, int>> batch;
+      for (int j = 0; j < 20; ++j) {
+        batch.push_back({static_cast<int>(gen() % 1000), i});
+      }
+      map.Insert(batch.begin(), batch.end());
+      expected.insert(batch.begin(), batch.end());
+    } else {
+      map.Insert(key, i);
+      expected.insert({key, i});
+    }
+  }
+  map.Erase(map.LowerBound(100), map.UpperBound(120));
+  expected.erase(expected.lower_bound(100), expected.upper_bound(120));
+  ASSERT_EQ(map.Size(), expected.size());
+  auto it = map.Begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(it.GetKey(), key);
+    ASSERT_EQ(it.GetVal(), value);
+    ++it;
+  }
+  EXPECT_TRUE(it == map.End());
+}
+
+TEST(FlatTest, BatchInsertKeepsFirst) {
+  s21::FlatMap<std::string, int> map{{"b", 1}, {"d", 2}};
+  map.Insert({{"c", 3}, {"a", 4}, {"b", 5}, {"c", 6}});
+  ASSERT_EQ(map.Size(), 4u);
+  EXPECT_EQ(map.At("b"), 1);
+  EXPECT_EQ(map.At("c"), 3);
+  EXPECT_EQ(map.Begin().GetKey(), "a");
+
+  s21::FlatSet<int> set{5, 3, 5, 1};
+  std::vector<int> more{4, 3, 2};
+  set.Insert(more.begin(), more.end());
+  EXPECT_EQ(set.Size(), 5u);
+  EXPECT_EQ(set.LowerBound(3).GetKey(), 3);
+  EXPECT_EQ(set.UpperBound(3).GetKey(), 4);
+}
+
+TEST(FlatTest, ReplaceAdoptsArrays) {
+  s21::Vector<int> keys{1, 2, 3};
+  s21::Vector<std::string> vals{"one", "two", "three"};
+  const int* data = keys.Data();
+  s21::FlatMap<int, std::string> map(std::move(keys), std::move(vals));
+  EXPECT_EQ(map.Begin().GetKeyPointer(), data);
+  EXPECT_EQ(map.At(2), "two");
+
+  s21::Vector<int> unsorted{3, 1, 3, 2};
+  s21::Vector<std::string> words{"c", "a", "x", "b"};
+  map.Replace(std::move(unsorted), std::move(words));
+  ASSERT_EQ(map.Size(), 3u);
+  EXPECT_EQ(map.At(3), "c");
+  auto last = map.End();
+  --last;
+  EXPECT_EQ(last.GetKey(), 3);
+
+  s21::Vector<int> short_keys{1};
+  s21::Vector<std::string> no_words;
+  EXPECT_THROW(map.Replace(std::move(short_keys), std::move(no_words)),
+               std::invalid_argument);
+
+  s21::FlatSet<int> set(s21::Vector<int>{2, 1});
+  EXPECT_EQ(set.Begin().GetKey(), 1);
+}
+
+TEST(FlatTest, MapInterface) {
+  s21::FlatMap<std::string, int> map;
+  map["b"] = 2;
+  EXPECT_TRUE(map.Emplace("a", 1).second);
+  EXPECT_FALSE(map.TryEmplace("a", 5).second);
+  EXPECT_TRUE(map.Emplace(std::piecewise_construct,
+                          std::forward_as_tuple(2, 'c'),
+                          std::forward_as_tuple(3))
+                  .second);
+  EXPECT_EQ(map.At("cc"), 3);
+  EXPECT_THROW(map.At("z"), std::out_of_range);
+  EXPECT_FALSE(map.InsertOrAssign("a", 10).second);
+  EXPECT_EQ(map.At("a"), 10);
+  EXPECT_TRUE(map.insert_or_assign("a", 11).second);
+  EXPECT_TRUE(map.Contains("b"));
+  auto range = map.EqualRange("b");
+  EXPECT_EQ(range.first.GetVal(), 2);
+  EXPECT_EQ(range.second.GetKey(), "cc");
+
+  s21::FlatMap<std::string, int> copy(map);
+  copy.Erase(copy.Begin());
+  EXPECT_EQ(map.Size(), 3u);
+  s21::FlatMap<std::string, int> other{{"a", 0}, {"d", 4}};
+  map.Merge(other);
+  EXPECT_EQ(map.Size(), 4u);
+  EXPECT_EQ(map.At("a"), 11);
+  ASSERT_EQ(other.Size(), 1u);
+  EXPECT_EQ(other.Begin().GetKey(), "a");
+  copy = map;
+  EXPECT_EQ(copy.At("d"), 4);
+}
+
+TEST(FlatTest, CollidingMergeIsLinear) {
+  constexpr int kCount = 20000;
+  s21::FlatMap<int, Tracked> map;
+  s21::FlatMap<int, Tracked> other;
+  for (int i = 0; i < kCount; ++i) {
+    map.Emplace(i, Tracked(i));
+    other.Emplace(i, Tracked(-i));
+  }
+  // Each value moves a fixed number of times into its new array; growing
+  // the array of kept values one slot at a time would move them about
+  // kCount^2 / 2 times.
+  Tracked::Reset();
+  map.Merge(other);
+  EXPECT_LE(Tracked::moves_, 4 * kCount);
+  EXPECT_EQ(Tracked::copies_, 0);
+  ASSERT_EQ(other.Size(), static_cast<std::size_t>(kCount));
+  EXPECT_EQ(map.At(kCount - 1).value_, kCount - 1);
+  EXPECT_EQ(other.At(kCount - 1).value_, 1 - kCount);
+}
+
+namespace {
+
+// Sends keys to four hash values, so they share a few probe sequences
+// that run through many full groups.
+struct FewHashes {
+  std::size_t operator()(int key) const {
+    return static_cast<std::size_t>(key % 4);
+  }
+};
+
+template <typename Table>
+void ExpectHashTableMatches(const Table& table,
+                            const std::map<int, int>& expected) {
+  ASSERT_EQ(table.Size(), expected.size());
+  std::size_t seen = 0;
+  for (auto it = table.Begin(); it != table.End(); ++it) {
+    auto found = expected.find(it.GetKey());
+    ASSERT_TRUE(found != expected.end());
+    ASSERT_EQ(it.GetVal(), found->second);
+    ++seen;
+  }
+  EXPECT_EQ(seen, expected.size());
+  for (const auto& [key, value] : expected) {
+    ASSERT_TRUE(table.Contains(key));
+    ASSERT_EQ(table.Find(key).GetVal(), value);
+  }
+}
+
+}  // namespace
+
+TEST(UnorderedTest, MatchesStdMap) {
+  std::mt19937 gen(37);
+  s21::UnorderedMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 30000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3 == 0) {
+      auto it = map.Find(key);
+      if (it != map.End()) map.Erase(it);
+      expected.erase(key);
+    } else {
+      map.Insert(key, i);
+      expected.insert({key, i});
+    }
+    ASSERT_LE(map.LoadFactor(), 0.875f);
+  }
+  ExpectHashTableMatches(map, expected);
+  EXPECT_FALSE(map.Contains(3000));
+}
+
+TEST(UnorderedTest, CollidingHashes) {
+  s21::UnorderedMap<int, int, FewHashes> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 500; ++i) {
+    map.Insert(i, -i);
+    expected.insert({i, -i});
+  }
+  // Erasing from full groups leaves deleted slots that later probes must
+  // walk past, and later insertions may fill.
+  for (int i = 0; i < 500; i += 2) {
+    map.Erase(map.Find(i));
+    expected.erase(i);
+  }
+  ExpectHashTableMatches(map, expected);
+  for (int i = 500; i < 700; ++i) {
+    map.Insert(i, -i);
+    expected.insert({i, -i});
+  }
+  ExpectHashTableMatches(map, expected);
+}
+
+TEST(UnorderedTest, ReserveAndRehash) {
+  s21::UnorderedSet<int> set;
+  EXPECT_EQ(set.BucketCount(), 0u);
+  EXPECT_TRUE(set.Begin() == set.End());
+  set.Reserve(1000);
+  std::size_t buckets = set.BucketCount();
+  EXPECT_GE(buckets, 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    set.Insert(i);
+  }
+  EXPECT_EQ(set.BucketCount(), buckets);
+  set.Erase(set.Begin(), set.End());
+  EXPECT_TRUE(set.Empty());
+  set.Insert(7);
+  set.Rehash(0);
+  EXPECT_EQ(set.BucketCount(), 16u);
+  EXPECT_TRUE(set.Contains(7));
+  set.Rehash(100);
+  EXPECT_EQ(set.BucketCount(), 128u);
+  EXPECT_EQ(set.Begin().GetKey(), 7);
+  set.Clear();
+  set.Rehash(0);
+  EXPECT_EQ(set.BucketCount(), 0u);
+}
+
+TEST(UnorderedTest, ChurnKeepsCapacity) {
+  s21::UnorderedSet<int> set;
+  for (int i = 0; i < 100; ++i) {
+    set.Insert(i);
+  }
+  std::size_t buckets = set.BucketCount();
+  // A dense table doubles once; after that, deleted slots are reclaimed by
+  // rehashing in place rather than by growing.
+  for (int i = 100; i < 1000; ++i) {
+    set.Erase(set.Find(i - 100));
+    set.Insert(i);
+  }
+  EXPECT_LE(set.BucketCount(), 2 * buckets);
+  buckets = set.BucketCount();
+  for (int i = 1000; i < 100000; ++i) {
+    set.Erase(set.Find(i - 100));
+    set.Insert(i);
+  }
+  EXPECT_EQ(set.Size(), 100u);
+  EXPECT_EQ(set.BucketCount(), buckets);
+  EXPECT_TRUE(set.Contains(99999));
+  EXPECT_FALSE(set.Contains(99899));
+}
+
+TEST(UnorderedTest, MapInterface) {
+  s21::UnorderedMap<std::string, int> map{{"b", 2}, {"a", 1}, {"b", 3}};
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.At("b"), 2);
+  EXPECT_THROW(map.At("z"), std::out_of_range);
+  map["c"] = 4;
+  EXPECT_EQ(map.At("c"), 4);
+  EXPECT_TRUE(map.Emplace("d", 5).second);
+  EXPECT_FALSE(map.Emplace(std::string("d"), 6).second);
+  EXPECT_TRUE(map.Emplace(std::piecewise_construct,
+                          std::forward_as_tuple(3, 'e'),
+                          std::forward_as_tuple(7))
+                  .second);
+  EXPECT_EQ(map.At("eee"), 7);
+  EXPECT_FALSE(map.InsertOrAssign("a", 10).second);
+  EXPECT_EQ(map.At("a"), 10);
+  EXPECT_TRUE(map.insert_or_assign("a", 11).second);
+  EXPECT_EQ(map.Count("c"), 1u);
+  EXPECT_FALSE(map.Contains("cc"));
+  auto range = map.EqualRange("c");
+  EXPECT_EQ(range.first.GetVal(), 4);
+  EXPECT_TRUE(map.EqualRange("cc").first == map.End());
+
+  // Erasure leaves the other iterators valid.
+  auto kept = map.Find("d");
+  map.Erase(map.Find("a"));
+  map.Erase(map.Find("b"));
+  EXPECT_EQ(kept.GetVal(), 5);
+
+  s21::UnorderedMap<std::string, int> copy(map);
+  copy.Erase(copy.Find("c"));
+  EXPECT_EQ(map.Size(), 3u);
+  s21::UnorderedMap<std::string, int> moved(std::move(copy));
+  EXPECT_TRUE(copy.Empty());
+  EXPECT_EQ(moved.Size(), 2u);
+  s21::UnorderedMap<std::string, int> other{{"c", 0}, {"f", 6}};
+  map.Merge(other);
+  EXPECT_EQ(map.Size(), 4u);
+  EXPECT_EQ(map.At("c"), 4);
+  EXPECT_EQ(map.At("f"), 6);
+  ASSERT_EQ(other.Size(), 1u);
+  EXPECT_EQ(other.Begin().GetKey(), "c");
+  moved = map;
+  EXPECT_EQ(moved.At("eee"), 7);
+}
+
 ///////////////////////////////
 
 TEST(StackTest, Constructor_default) {
@@ -2305,6 +3923,18 @@ TEST(ListTest, EmptyList2) {
   ASSERT_TRUE(list.Empty());
 }
 
+TEST(ListTest, EmptyListEnd) {
+  // Built over garbage, so links the constructor leaves unset would show.
+  alignas(s21::List<int>) unsigned char storage[sizeof(s21::List<int>)];
+  std::memset(storage, 0xA5, sizeof(storage));
+  auto* list = new (storage) s21::List<int>;
+  auto end = list->End();
+  --end;
+  EXPECT_EQ(end, list->End());
+  EXPECT_EQ(list->Begin(), list->End());
+  list->~List();
+}
+
 TEST(ListTest, sort) {
   s21::List<double> s21lone{7.19};
   s21lone.Sort();
@@ -2913,7 +4543,6 @@ TEST(ListTest, TEST_) {
   std::list<int> original{0, 0, 0, 0, 0, 0, 0};
   std::list<int>::iterator it_orig = original.begin();
   original.insert(it_orig, -999);
-  original.begin();
   for (it_orig = original.begin(); it_orig != original.end(); ++it_orig) {
     EXPECT_EQ(*it, *it_orig);
     ++it;
@@ -3422,6 +5051,16 @@ TEST(vector_erase, case2) {
   EXPECT_EQ(s21_vec_string[0], "Hello");
 }
 
+TEST(vector_erase, range) {
+  s21::Vector<std::string> s21_vec_string{"a", "b", "c", "d", "e"};
+  s21_vec_string.Erase(s21_vec_string.Begin() + 1, s21_vec_string.Begin() + 3);
+  ASSERT_EQ(s21_vec_string.Size(), 3U);
+  EXPECT_EQ(s21_vec_string[1], "d");
+  EXPECT_EQ(s21_vec_string.Capacity(), 5U);
+  s21_vec_string.Erase(s21_vec_string.Begin(), s21_vec_string.End());
+  EXPECT_TRUE(s21_vec_string.Empty());
+}
+
 TEST(vector_push_back, case1) {
   s21::Vector<int> s21_vec_int{1, 4, 8, 9};
   s21::Vector<double> s21_vec_double{1.4, 4.8, 8.9, 9.1};
@@ -3454,6 +5093,16 @@ TEST(vector_push_back, case2) {
   EXPECT_EQ(*(s21_vec_string.End() - 1), "!!");
 }
 
+TEST(vector_push_back, move) {
+  s21::Vector<std::unique_ptr<int>> s21_vec_ptr;
+  s21_vec_ptr.PushBack(std::make_unique<int>(1));
+  s21_vec_ptr.Insert(s21_vec_ptr.Begin(), std::make_unique<int>(0));
+  s21_vec_ptr.PushBack(std::make_unique<int>(2));
+  ASSERT_EQ(s21_vec_ptr.Size(), 3U);
+  EXPECT_EQ(*s21_vec_ptr[0], 0);
+  EXPECT_EQ(*s21_vec_ptr[2], 2);
+}
+
 TEST(vector_pop_back, case1) {
   s21::Vector<int> s21_vec_int{1, 4, 8, 9};
   s21::Vector<double> s21_vec_double{1.4, 4.8, 8.9, 9.1};
@@ -3549,6 +5198,734 @@ TEST(QueueTest, MoveAssignmentOperator) {
 
   ASSERT_TRUE(q1.Empty());
 }
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(int* live, int id = 0, int* peak = nullptr)
+      : live_(live), id_(id), peak_(peak) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& other)
+      : live_(other.live_), id_(other.id_), peak_(other.peak_) {}
+
+  T* allocate(std::size_t n) {
+    *live_ += static_cast<int>(n * sizeof(T));
+    if (peak_ != nullptr) *peak_ = std::max(*peak_, *live_);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    *live_ -= static_cast<int>(n * sizeof(T));
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& other) const {
+    return id_ == other.id_;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>& other) const {
+    return id_ != other.id_;
+  }
+
+  int* live_;
+  int id_;
+  // Highest value live_ has reached, if not null.
+  int* peak_;
+};
+
+TEST(AllocatorTest, Vector) {
+  int live = 0;
+  {
+    s21::Vector<int, CountingAllocator<int>> v{CountingAllocator<int>(&live)};
+    for (int i = 0; i < 100; ++i) {
+      v.PushBack(i);
+    }
+    EXPECT_GE(live, static_cast<int>(100 * sizeof(int)));
+    EXPECT_EQ(v[99], 99);
+    EXPECT_EQ(v.GetAllocator().live_, &live);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, List) {
+  int live = 0;
+  {
+    s21::List<std::string, CountingAllocator<std::string>> l(
+        {"a", "b", "c"}, CountingAllocator<std::string>(&live));
+    EXPECT_GT(live, 0);
+    l.PushFront("z");
+    EXPECT_EQ(l.Front(), "z");
+    EXPECT_EQ(l.Size(), 4);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, StackAndQueue) {
+  int live = 0;
+  {
+    s21::Stack<int, CountingAllocator<int>> s{CountingAllocator<int>(&live)};
+    s21::Queue<int, CountingAllocator<int>> q{CountingAllocator<int>(&live)};
+    for (int i = 0; i < 10; ++i) {
+      s.Push(i);
+      q.Push(i);
+    }
+    EXPECT_GT(live, 0);
+    EXPECT_EQ(s.Top(), 9);
+    EXPECT_EQ(q.Front(), 0);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, MapAndSet) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  int live = 0;
+  {
+    s21::Map<int, int, std::less<int>, Alloc> map{Alloc(&live)};
+    s21::Set<int, std::less<int>, CountingAllocator<int>> set{
+        CountingAllocator<int>(&live)};
+    EXPECT_EQ(live, 0);
+    for (int i = 0; i < 1000; ++i) {
+      map.Insert(i, i * 2);
+      set.Insert(i);
+    }
+    EXPECT_EQ(map.At(500), 1000);
+    EXPECT_TRUE(set.Contains(999));
+    s21::Map<int, int, std::less<int>, Alloc> copy(map);
+    EXPECT_EQ(copy.GetAllocator(), map.GetAllocator());
+    EXPECT_EQ(copy.At(999), 1998);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, MoveAssignUnequal) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  int live_a = 0;
+  int live_b = 0;
+  {
+    s21::Map<int, int, std::less<int>, Alloc> a{Alloc(&live_a, 1)};
+    s21::Map<int, int, std::less<int>, Alloc> b({{1, 10}, {2, 20}},
+                                                Alloc(&live_b, 2));
+    a = std::move(b);
+    EXPECT_EQ(a.GetAllocator().id_, 1);
+    EXPECT_EQ(a.At(2), 20);
+    EXPECT_EQ(a.Size(), 2);
+    EXPECT_TRUE(b.Empty());
+
+    using IntAlloc = CountingAllocator<int>;
+    s21::Multiset<int, std::less<int>, IntAlloc> ms1{IntAlloc(&live_a, 1)};
+    s21::Multiset<int, std::less<int>, IntAlloc> ms2({5, 5, 5, 7},
+                                                     IntAlloc(&live_b, 2));
+    ms1 = std::move(ms2);
+    EXPECT_EQ(ms1.GetAllocator().id_, 1);
+    EXPECT_EQ(ms1.Size(), 4u);
+    EXPECT_EQ(ms1.Count(5), 3u);
+    EXPECT_TRUE(ms2.Empty());
+
+    s21::Multimap<int, int, std::less<int>, Alloc> mm1{Alloc(&live_a, 1)};
+    s21::Multimap<int, int, std::less<int>, Alloc> mm2({{1, 1}, {1, 2}},
+                                                       Alloc(&live_b, 2));
+    mm1 = std::move(mm2);
+    ASSERT_EQ(mm1.Size(), 2u);
+    auto second = mm1.Begin();
+    ++second;
+    EXPECT_EQ(mm1.Begin().GetVal(), 1);
+    EXPECT_EQ(second.GetVal(), 2);
+
+    s21::Vector<int, CountingAllocator<int>> v1{
+        CountingAllocator<int>(&live_a, 1)};
+    s21::Vector<int, CountingAllocator<int>> v2(
+        {1, 2, 3}, CountingAllocator<int>(&live_b, 2));
+    v1 = std::move(v2);
+    EXPECT_EQ(v1.GetAllocator().id_, 1);
+    EXPECT_EQ(v1.Size(), 3);
+    EXPECT_EQ(v1[2], 3);
+  }
+  EXPECT_EQ(live_a, 0);
+  EXPECT_EQ(live_b, 0);
+}
+
+TEST(AllocatorTest, CollidingMergesKeepMemory) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  using CountedMap = s21::Map<int, int, std::less<int>, Alloc>;
+  int live = 0;
+  {
+    CountedMap target{Alloc(&live)};
+    for (int i = 0; i < 1000; ++i) {
+      target.Insert(i, i);
+    }
+    int memory = 0;
+    for (int round = 0; round < 200; ++round) {
+      // The first round may grow the pool; after that the slot of the erased
+      // key is reused instead of delta's memory being kept alive.
+      if (round == 1) memory = live;
+      CountedMap delta{Alloc(&live)};
+      for (int i = 0; i < 1000; ++i) {
+        delta.Insert(i, -i);
+      }
+      delta.Insert(1000 + round, round);
+      target.Merge(delta);
+      ASSERT_EQ(delta.Size(), 1000u);
+      ASSERT_EQ(target.At(1000 + round), round);
+      target.Erase(target.Find(1000 + round));
+    }
+    EXPECT_EQ(live, memory);
+    EXPECT_EQ(target.Size(), 1000u);
+    EXPECT_EQ(target.At(999), 999);
+
+    // A delta of new keys is still relinked rather than copied.
+    CountedMap fresh{Alloc(&live)};
+    for (int i = 2000; i < 3000; ++i) {
+      fresh.Insert(i, i);
+    }
+    const int* value = &fresh.At(2500);
+    target.Merge(fresh);
+    EXPECT_TRUE(fresh.Empty());
+    EXPECT_EQ(&target.At(2500), value);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, SplitJoinKeepMemory) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  using CountedMap = s21::Map<int, int, std::less<int>, Alloc>;
+  int live = 0;
+  {
+    CountedMap tree{Alloc(&live)};
+    for (int i = 0; i < 1000; ++i) {
+      tree.Insert(i, i);
+    }
+    CountedMap upper{Alloc(&live)};
+    int memory = 0;
+    for (int round = 0; round < 200; ++round) {
+      // Rounds 0 and 1 split off 100 and 900 elements, so upper's pool may
+      // grow twice. From then on freed slots are reused on both sides.
+      if (round == 2) memory = live;
+      tree.Split(round % 2 == 0 ? 900 : 100, upper);
+      ASSERT_EQ(tree.Size() + upper.Size(), 1000u);
+      tree.Join(upper);
+      ASSERT_TRUE(upper.Empty());
+      CountedMap same{Alloc(&live)};
+      for (int i = 0; i < 1000; i += 10) {
+        same.Insert(i, -i);
+      }
+      tree.Union(same);
+      ASSERT_TRUE(same.Empty());
+    }
+    EXPECT_EQ(live, memory);
+    ASSERT_EQ(tree.Size(), 1000u);
+    int prev = -1;
+    for (auto it = tree.Begin(); it != tree.End(); ++it) {
+      EXPECT_EQ(it.GetKey(), prev + 1);
+      EXPECT_EQ(it.GetVal(), it.GetKey());
+      prev = it.GetKey();
+    }
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, ClearKeepsMemory) {
+  using Alloc = CountingAllocator<std::pair<const int, std::string>>;
+  int live = 0;
+  {
+    s21::Map<int, std::string, std::less<int>, Alloc> map{Alloc(&live)};
+    for (int i = 0; i < 1000; ++i) {
+      map.Insert(i, std::string(40, 'x'));
+    }
+    int full = live;
+    auto end = map.End();
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(map.End(), end);
+    EXPECT_EQ(live, full);
+    for (int i = 0; i < 1000; ++i) {
+      map.Insert(-i, "again");
+    }
+    EXPECT_EQ(live, full);
+    EXPECT_EQ(map.Size(), 1000);
+    EXPECT_EQ(map.Begin().GetKey(), -999);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, EmptyContainersOwnNoMemory) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  int live = 0;
+  {
+    s21::Map<int, int, std::less<int>, Alloc> map{Alloc(&live)};
+    s21::Set<int, std::less<int>, CountingAllocator<int>> set{
+        CountingAllocator<int>(&live)};
+    s21::List<int, CountingAllocator<int>> list{CountingAllocator<int>(&live)};
+    auto moved_map = std::move(map);
+    auto moved_set = std::move(set);
+    auto moved_list = std::move(list);
+    map.Swap(moved_map);
+    list.Swap(moved_list);
+    EXPECT_EQ(live, 0);
+
+    // Moved-from containers keep an End() of their own and can be refilled.
+    moved_map.Insert(1, 10);
+    moved_set.Insert(2);
+    set = std::move(moved_set);
+    moved_set.Insert(3);
+    moved_list.PushBack(4);
+    list = std::move(moved_list);
+    moved_list.PushBack(5);
+    EXPECT_GT(live, 0);
+    auto last = moved_map.End();
+    --last;
+    EXPECT_EQ(last.GetVal(), 10);
+    auto first = set.Begin();
+    EXPECT_EQ(first.GetKey(), 2);
+    ++first;
+    EXPECT_EQ(first, set.End());
+    EXPECT_EQ(moved_set.Begin().GetKey(), 3);
+    EXPECT_EQ(list.Front(), 4);
+    EXPECT_EQ(++list.Begin(), list.End());
+    EXPECT_EQ(moved_list.Front(), 5);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+// Has no default constructor.
+struct Reading {
+  explicit Reading(double value) : value_(value) {}
+  double value_;
+};
+
+TEST(AllocatorTest, ValuesNeedNoDefaultConstructor) {
+  s21::Map<int, Reading> map;
+  map.Insert(2, Reading(0.5));
+  map.Insert(1, Reading(1.5));
+  s21::Map<int, Reading> other;
+  other.Swap(map);
+  EXPECT_TRUE(map.Empty());
+  EXPECT_DOUBLE_EQ(other.At(1).value_, 1.5);
+  auto last = other.End();
+  --last;
+  EXPECT_DOUBLE_EQ(last.GetVal().value_, 0.5);
+
+  s21::List<Reading> list;
+  list.PushBack(Reading(2.5));
+  list.PushFront(Reading(3.5));
+  s21::List<Reading> moved(std::move(list));
+  EXPECT_DOUBLE_EQ(moved.Front().value_, 3.5);
+  EXPECT_DOUBLE_EQ(moved.Back().value_, 2.5);
+  EXPECT_TRUE(list.Empty());
+}
+
+struct ReadingLess {
+  bool operator()(const Reading& a, const Reading& b) const {
+    return a.value_ < b.value_;
+  }
+};
+
+TEST(AllocatorTest, KeysNeedNoDefaultConstructor) {
+  // Set nodes hold no value, so they are no bigger than the key needs.
+  static_assert(sizeof(s21::Node<std::array<int, 4>, void>) <
+                sizeof(s21::Node<std::array<int, 4>, std::array<int, 4>>));
+  s21::Set<Reading, ReadingLess> set;
+  EXPECT_TRUE(set.Insert(Reading(2.5)).second);
+  EXPECT_TRUE(set.Emplace(0.5).second);
+  EXPECT_FALSE(set.Insert(Reading(2.5)).second);
+  s21::Set<Reading, ReadingLess> copy(set);
+  EXPECT_EQ(copy.Size(), 2u);
+  EXPECT_DOUBLE_EQ(copy.Begin().GetKey().value_, 0.5);
+  auto handle = copy.Extract(copy.Begin());
+  EXPECT_DOUBLE_EQ(handle.GetKey().value_, 0.5);
+  EXPECT_FALSE(set.Insert(std::move(handle)).second);
+
+  s21::Multiset<Reading, ReadingLess> multiset;
+  multiset.Insert(Reading(1.5));
+  multiset.Insert(Reading(1.5));
+  EXPECT_EQ(multiset.Size(), 2u);
+  EXPECT_DOUBLE_EQ(multiset.Begin().GetKey().value_, 1.5);
+}
+
+namespace {
+
+// Value whose copies throw once copy_budget_ is spent. The counters are
+// atomic because a tall tree is cloned on several threads.
+struct Fragile {
+  Fragile() { ++alive_; }
+  Fragile(const Fragile&) {
+    if (copy_budget_.fetch_sub(1) <= 0) {
+      throw std::runtime_error("copy failed");
+    }
+    ++alive_;
+  }
+  ~Fragile() { --alive_; }
+
+  static std::atomic<int> copy_budget_;
+  static std::atomic<int> alive_;
+};
+
+std::atomic<int> Fragile::copy_budget_{0};
+std::atomic<int> Fragile::alive_{0};
+
+}  // namespace
+
+TEST(AllocatorTest, ThrowingCopyFreesNodes) {
+  using Alloc = CountingAllocator<std::pair<const int, Fragile>>;
+  using FragileMap = s21::Map<int, Fragile, std::less<int>, Alloc>;
+  constexpr int kCount = 1 << 15;
+  int live = 0;
+  {
+    Fragile::copy_budget_ = std::numeric_limits<int>::max();
+    FragileMap original{Alloc(&live)};
+    for (int i = 0; i < kCount; ++i) {
+      original.Insert(i, Fragile());
+    }
+    // Tall enough for the left halves to be cloned on other threads.
+    ASSERT_GE(BlackHeight(original.GetRoot()), 10);
+    int alive = Fragile::alive_;
+    int memory = live;
+    for (int budget : {0, 1, 1000, kCount / 2, kCount - 1}) {
+      Fragile::copy_budget_ = budget;
+      EXPECT_THROW(FragileMap copy(original), std::runtime_error);
+      EXPECT_EQ(Fragile::alive_, alive);
+      EXPECT_EQ(live, memory);
+    }
+
+    Fragile::copy_budget_ = std::numeric_limits<int>::max();
+    FragileMap target{Alloc(&live)};
+    target.Insert(-1, Fragile());
+    alive = Fragile::alive_;
+    memory = live;
+    Fragile::copy_budget_ = kCount / 3;
+    EXPECT_THROW(target = original, std::runtime_error);
+    EXPECT_EQ(Fragile::alive_, alive);
+    EXPECT_EQ(live, memory);
+    ASSERT_EQ(target.Size(), 1u);
+    EXPECT_EQ(target.Begin().GetKey(), -1);
+  }
+  EXPECT_EQ(Fragile::alive_, 0);
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, BTreeMap) {
+  using Alloc = CountingAllocator<std::pair<const int, Reading>>;
+  int live_a = 0;
+  int live_b = 0;
+  {
+    s21::BTreeMap<int, Reading, std::less<int>, Alloc> a{Alloc(&live_a, 1)};
+    s21::BTreeMap<int, Reading, std::less<int>, Alloc> b{Alloc(&live_b, 2)};
+    EXPECT_EQ(live_b, 0);
+    for (int i = 0; i < 1000; ++i) {
+      b.Insert(i, Reading(i * 0.5));
+    }
+    EXPECT_GT(live_b, 0);
+    a = std::move(b);
+    EXPECT_EQ(a.GetAllocator().id_, 1);
+    EXPECT_EQ(live_b, 0);
+    EXPECT_DOUBLE_EQ(a.At(999).value_, 499.5);
+    a.Erase(a.Begin(), a.Find(990));
+    EXPECT_EQ(a.Size(), 10u);
+  }
+  EXPECT_EQ(live_a, 0);
+  EXPECT_EQ(live_b, 0);
+}
+
+TEST(AllocatorTest, FlatMapStaging) {
+  using Alloc = CountingAllocator<std::pair<const int, double>>;
+  using Flat = s21::FlatMap<int, double, std::less<int>, Alloc>;
+  constexpr int kCount = 1000;
+  int live = 0;
+  int peak = 0;
+  {
+    std::vector<std::pair<int, double>> items;
+    for (int i = 0; i < kCount; ++i) {
+      items.emplace_back(kCount - i, i * 0.5);
+    }
+    // The sorting buffers come from the allocator too, so they show up in
+    // the peak on top of the arrays that remain.
+    Flat map(items.begin(), items.end(), Alloc(&live, 0, &peak));
+    EXPECT_EQ(map.Size(), static_cast<std::size_t>(kCount));
+    EXPECT_GE(peak - live,
+              static_cast<int>(kCount * sizeof(std::pair<int, double>)));
+
+    Flat::key_container keys{CountingAllocator<int>(&live, 0, &peak)};
+    Flat::mapped_container vals{CountingAllocator<double>(&live, 0, &peak)};
+    for (int i = 0; i < kCount; ++i) {
+      keys.PushBack(kCount - i);
+      vals.PushBack(i * 0.5);
+    }
+    peak = live;
+    Flat replaced(std::move(keys), std::move(vals), std::less<int>(),
+                  Alloc(&live, 0, &peak));
+    EXPECT_GE(peak - live, static_cast<int>(kCount * sizeof(std::size_t)));
+    EXPECT_DOUBLE_EQ(replaced.At(1), (kCount - 1) * 0.5);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(AllocatorTest, UnorderedMap) {
+  using Alloc = CountingAllocator<std::pair<const int, Reading>>;
+  int live_a = 0;
+  int live_b = 0;
+  {
+    using Table = s21::UnorderedMap<int, Reading, std::hash<int>,
+                                    std::equal_to<int>, Alloc>;
+    Table a{Alloc(&live_a, 1)};
+    Table b{Alloc(&live_b, 2)};
+    EXPECT_EQ(live_b, 0);
+    for (int i = 0; i < 1000; ++i) {
+      b.Insert(i, Reading(i * 0.5));
+    }
+    EXPECT_GT(live_b, 0);
+    a = std::move(b);
+    EXPECT_EQ(a.GetAllocator().id_, 1);
+    EXPECT_EQ(live_b, 0);
+    EXPECT_DOUBLE_EQ(a.At(999).value_, 499.5);
+    Table copy(a);
+    EXPECT_DOUBLE_EQ(copy.At(10).value_, 5.0);
+    a.Clear();
+    a.Rehash(0);
+    EXPECT_EQ(a.BucketCount(), 0u);
+  }
+  EXPECT_EQ(live_a, 0);
+  EXPECT_EQ(live_b, 0);
+}
+
+// Records the thread that destroys it.
+struct DeathRecorder {
+  explicit DeathRecorder(std::thread::id* dead) : dead_(dead) {}
+  DeathRecorder(DeathRecorder&& other) noexcept
+      : dead_(std::exchange(other.dead_, nullptr)) {}
+  ~DeathRecorder() {
+    if (dead_ != nullptr) *dead_ = std::this_thread::get_id();
+  }
+  std::thread::id* dead_;
+};
+
+TEST(ReclaimerTest, DestroysOnBackgroundThread) {
+  using Alloc = CountingAllocator<std::pair<const int, std::string>>;
+  int live = 0;
+  s21::Map<int, std::string, std::less<int>, Alloc> map{Alloc(&live)};
+  s21::List<int, CountingAllocator<int>> list{CountingAllocator<int>(&live)};
+  for (int i = 0; i < 10000; ++i) {
+    map.Insert(i, std::to_string(i));
+    list.PushBack(i);
+  }
+  s21::DeferredDelete(std::move(map));
+  s21::DeferredDelete(std::move(list));
+  EXPECT_TRUE(map.Empty());
+  s21::Reclaimer::Instance().Flush();
+  EXPECT_EQ(s21::Reclaimer::Instance().Backlog(), 0u);
+  EXPECT_EQ(live, 0);
+
+  std::thread::id dead;
+  {
+    s21::Reclaimer reclaimer(4);
+    reclaimer.Retire(DeathRecorder(&dead));
+  }
+  EXPECT_NE(dead, std::thread::id());
+  EXPECT_NE(dead, std::this_thread::get_id());
+}
+
+TEST(ReclaimerTest, FullBacklogDestroysInline) {
+  std::thread::id dead;
+  s21::Reclaimer inline_only(0);
+  inline_only.Retire(DeathRecorder(&dead));
+  EXPECT_EQ(dead, std::this_thread::get_id());
+  EXPECT_EQ(inline_only.Backlog(), 0u);
+
+  s21::Reclaimer reclaimer(2);
+  std::vector<std::thread::id> deaths(50);
+  for (auto& death : deaths) {
+    reclaimer.Retire(DeathRecorder(&death));
+    EXPECT_LE(reclaimer.Backlog(), 3u);
+  }
+  reclaimer.Flush();
+  for (const auto& death : deaths) {
+    EXPECT_NE(death, std::thread::id());
+  }
+}
+
+TEST(ConcurrentReadTest, ConstMapNeedsNoLock) {
+  s21::Map<int, int> source;
+  for (int i = 0; i < 2000; ++i) {
+    source.Insert(i * 3, i);
+  }
+  const s21::Map<int, int>& map = source;
+  std::vector<long> sums(4);
+  std::vector<std::thread> readers;
+  for (std::size_t t = 0; t < sums.size(); ++t) {
+    readers.emplace_back([&map, &sums, t] {
+      for (int round = 0; round < 20; ++round) {
+        long sum = 0;
+        for (auto it = map.CBegin(); it != map.CEnd(); ++it) {
+          sum += it.GetVal();
+        }
+        auto back = map.End();
+        --back;
+        sum += back.GetKey();
+        sum += map.At(300) + map.Find(300).GetKey() + map.Count(9);
+        sum += map.LowerBound(10).GetKey() + map.UpperBound(10).GetKey();
+        sums[t] = sum;
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  long expected = 1999L * 2000 / 2 + 5997 + 100 + 300 + 1 + 12 + 12;
+  for (long sum : sums) {
+    EXPECT_EQ(sum, expected);
+  }
+}
+
+TEST(NodeHandleTest, MovesEntriesBetweenMaps) {
+  s21::Map<int, std::string> from{{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::Map<int, std::string> to{{5, "five"}};
+  auto node = from.Extract(2);
+  ASSERT_FALSE(node.Empty());
+  EXPECT_EQ(node.GetKey(), 2);
+  const std::string* value = &node.GetVal();
+  EXPECT_EQ(from.Size(), 2);
+  EXPECT_FALSE(from.Contains(2));
+
+  auto result = to.Insert(std::move(node));
+  EXPECT_TRUE(result.second);
+  EXPECT_TRUE(node.Empty());
+  EXPECT_EQ(&result.first.GetVal(), value);
+  EXPECT_EQ(to.At(2), "two");
+  EXPECT_EQ(to.Size(), 2);
+
+  node = from.Extract(from.Begin());
+  EXPECT_EQ(node.GetVal(), "one");
+  to.Insert(to.Begin(), std::move(node));
+  node = from.Extract(from.Begin());
+  to.Insert(std::move(node));
+  EXPECT_TRUE(from.Empty());
+  EXPECT_EQ(from.Begin(), from.End());
+  std::vector<int> keys;
+  for (auto it = to.Begin(); it != to.End(); ++it) {
+    keys.push_back(it.GetKey());
+  }
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 5}));
+
+  EXPECT_TRUE(from.Extract(from.End()).Empty());
+  EXPECT_FALSE(to.Extract(4));
+  auto empty = to.Insert(s21::Map<int, std::string>::node_type());
+  EXPECT_FALSE(empty.second);
+  EXPECT_EQ(empty.first, to.End());
+}
+
+TEST(NodeHandleTest, ChangeKeyAndDuplicates) {
+  s21::Set<int> set{1, 2, 3, 4};
+  auto node = set.Extract(3);
+  node.GetKey() = 10;
+  EXPECT_TRUE(set.Insert(std::move(node)).second);
+  std::vector<int> keys;
+  for (auto it = set.Begin(); it != set.End(); ++it) {
+    keys.push_back(it.GetKey());
+  }
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 4, 10}));
+
+  s21::Set<int> other{4, 7};
+  node = other.Extract(4);
+  auto result = set.Insert(std::move(node));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first.GetKey(), 4);
+  ASSERT_FALSE(node.Empty());
+  EXPECT_EQ(node.GetKey(), 4);
+  EXPECT_EQ(set.Size(), 4);
+  EXPECT_EQ(other.Size(), 1);
+}
+
+TEST(NodeHandleTest, OutlivesSource) {
+  auto shared = std::make_shared<int>(42);
+  s21::Map<int, std::shared_ptr<int>>::node_type node;
+  {
+    s21::Map<int, std::shared_ptr<int>> source;
+    for (int i = 0; i < 100; ++i) {
+      source.Insert(i, shared);
+    }
+    node = source.Extract(50);
+  }
+  EXPECT_EQ(shared.use_count(), 2);
+  EXPECT_EQ(*node.GetVal(), 42);
+
+  s21::Map<int, std::shared_ptr<int>> target;
+  target.Insert(std::move(node));
+  EXPECT_EQ(*target.At(50), 42);
+  node = target.Extract(50);
+  node = s21::Map<int, std::shared_ptr<int>>::node_type();
+  EXPECT_EQ(shared.use_count(), 1);
+  EXPECT_TRUE(target.Empty());
+}
+
+TEST(NodeHandleTest, NoAllocationInSteadyState) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  int live = 0;
+  {
+    s21::Map<int, int, std::less<int>, Alloc> a{Alloc(&live)};
+    s21::Map<int, int, std::less<int>, Alloc> b{Alloc(&live)};
+    for (int i = 0; i < 100; ++i) {
+      a.Insert(i, i);
+      b.Insert(i + 100, i);
+    }
+    b.Insert(a.Extract(0));
+    a.Insert(b.Extract(100));
+    int warm = live;
+    for (int i = 1; i < 100; ++i) {
+      b.Insert(a.Extract(i));
+      a.Insert(b.Extract(i + 100));
+    }
+    EXPECT_EQ(live, warm);
+    EXPECT_EQ(a.Size(), 100);
+    EXPECT_EQ(b.Size(), 100);
+    EXPECT_EQ(a.At(150), 50);
+    EXPECT_EQ(b.At(50), 50);
+
+    s21::Map<int, int, std::less<int>, Alloc> c{Alloc(&live, 1)};
+    auto result = c.Insert(a.Extract(150));
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(c.At(150), 50);
+    EXPECT_FALSE(a.Contains(150));
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(NodeHandleTest, DroppedNodesReturnSlots) {
+  using Alloc = CountingAllocator<std::pair<const int, int>>;
+  using CountedMap = s21::Map<int, int, std::less<int>, Alloc>;
+  int live = 0;
+  {
+    CountedMap map{Alloc(&live)};
+    for (int i = 0; i < 1000; ++i) {
+      map.Insert(i, i);
+    }
+    int memory = 0;
+    for (int round = 0; round < 20000; ++round) {
+      // The first extract seals the slabs and creates the bin.
+      if (round == 1) memory = live;
+      int key = round % 1000;
+      {
+        auto node = map.Extract(key);
+        ASSERT_EQ(node.GetVal(), round < 1000 ? key : round - 1000);
+      }
+      map.Insert(key, round);
+    }
+    EXPECT_EQ(live, memory);
+
+    // Handles may also be dropped on another thread.
+    std::vector<CountedMap::node_type> nodes;
+    for (int i = 0; i < 500; ++i) {
+      nodes.push_back(map.Extract(i));
+    }
+    int with_nodes = live;
+    std::thread([&nodes] { nodes.clear(); }).join();
+    for (int i = 0; i < 500; ++i) {
+      map.Insert(i, -i);
+    }
+    EXPECT_EQ(live, with_nodes);
+    EXPECT_EQ(map.Size(), 1000u);
+    EXPECT_EQ(map.At(499), -499);
+  }
+  EXPECT_EQ(live, 0);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 